@@ -0,0 +1,456 @@
+#ifndef AIO_BROADCAST_H
+#define AIO_BROADCAST_H
+
+#include "channel.h"
+#include <array>
+
+namespace aio {
+    enum LagPolicy {
+        BLOCK_SENDER,
+        DROP_OLDEST,
+        DISCONNECT_SUBSCRIBER
+    };
+
+    template<typename T, size_t N>
+    class Broadcast;
+
+    template<typename T, size_t N>
+    class Subscriber : public IReceiver<std::shared_ptr<const T>> {
+    private:
+        Subscriber(zero::ptr::RefPtr<Broadcast<T, N>> broadcast, size_t cursor)
+                : mBroadcast(std::move(broadcast)), mCursor(cursor), mDropped(0), mDisconnected(false) {
+
+        }
+
+    public:
+        Subscriber(const Subscriber &) = delete;
+
+        ~Subscriber() override {
+            mBroadcast->unsubscribe(this);
+        }
+
+    public:
+        Subscriber &operator=(const Subscriber &) = delete;
+
+    public:
+        nonstd::expected<std::shared_ptr<const T>, Error> receiveSync() override {
+            return mBroadcast->receiveSync(this, std::nullopt);
+        }
+
+        nonstd::expected<std::shared_ptr<const T>, Error> receiveSync(std::chrono::milliseconds timeout) override {
+            return mBroadcast->receiveSync(this, std::make_optional<std::chrono::milliseconds>(timeout));
+        }
+
+        nonstd::expected<std::shared_ptr<const T>, Error> tryReceive() override {
+            return mBroadcast->tryReceive(this);
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<std::shared_ptr<const T>>> receive() override {
+            return mBroadcast->receive(this, std::nullopt);
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<std::shared_ptr<const T>>>
+        receive(std::chrono::milliseconds timeout) override {
+            return mBroadcast->receive(this, std::make_optional<std::chrono::milliseconds>(timeout));
+        }
+
+    public:
+        size_t dropped() {
+            std::lock_guard<std::mutex> guard(mBroadcast->mMutex);
+            return mDropped;
+        }
+
+    private:
+        zero::ptr::RefPtr<Broadcast<T, N>> mBroadcast;
+        size_t mCursor;
+        size_t mDropped;
+        bool mDisconnected;
+
+        friend class Broadcast<T, N>;
+
+        template<typename Subscriber, typename ...Args>
+        friend zero::ptr::RefPtr<Subscriber> zero::ptr::makeRef(Args &&... args);
+    };
+
+    template<typename T, size_t N>
+    class Broadcast : public ISender<T> {
+    private:
+        static constexpr auto SENDER = 0;
+        static constexpr auto RECEIVER = 1;
+
+    private:
+        explicit Broadcast(std::shared_ptr<Context> context, LagPolicy policy = BLOCK_SENDER)
+                : mClosed(false), mHead(0), mPolicy(policy), mContext(std::move(context)) {
+
+        }
+
+    public:
+        Broadcast(const Broadcast &) = delete;
+        Broadcast &operator=(const Broadcast &) = delete;
+
+    public:
+        zero::ptr::RefPtr<Subscriber<T, N>> subscribe() {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            zero::ptr::RefPtr<Subscriber<T, N>> subscriber = zero::ptr::makeRef<Subscriber<T, N>>(
+                    zero::ptr::RefPtr<Broadcast>(this),
+                    mHead
+            );
+
+            mSubscribers.push_back(subscriber.get());
+            return subscriber;
+        }
+
+    public:
+        nonstd::expected<void, Error> sendSync(const T &element) override {
+            return sendSync(std::make_shared<const T>(element), std::nullopt);
+        }
+
+        nonstd::expected<void, Error> sendSync(const T &element, std::chrono::milliseconds timeout) override {
+            return sendSync(
+                    std::make_shared<const T>(element),
+                    std::make_optional<std::chrono::milliseconds>(timeout)
+            );
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<void>> send(const T &element) override {
+            return send(std::make_shared<const T>(element), std::nullopt);
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<void>>
+        send(const T &element, std::chrono::milliseconds timeout) override {
+            return send(std::make_shared<const T>(element), std::make_optional<std::chrono::milliseconds>(timeout));
+        }
+
+        nonstd::expected<void, Error> trySend(const T &element) override {
+            return trySend(std::make_shared<const T>(element));
+        }
+
+    public:
+        nonstd::expected<void, Error> sendSync(T &&element) override {
+            return sendSync(std::make_shared<const T>(std::move(element)), std::nullopt);
+        }
+
+        nonstd::expected<void, Error> sendSync(T &&element, std::chrono::milliseconds timeout) override {
+            return sendSync(
+                    std::make_shared<const T>(std::move(element)),
+                    std::make_optional<std::chrono::milliseconds>(timeout)
+            );
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<void>> send(T &&element) override {
+            return send(std::make_shared<const T>(std::move(element)), std::nullopt);
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<void>>
+        send(T &&element, std::chrono::milliseconds timeout) override {
+            return send(
+                    std::make_shared<const T>(std::move(element)),
+                    std::make_optional<std::chrono::milliseconds>(timeout)
+            );
+        }
+
+        nonstd::expected<void, Error> trySend(T &&element) override {
+            return trySend(std::make_shared<const T>(std::move(element)));
+        }
+
+    public:
+        nonstd::expected<void, Error> trySend(std::shared_ptr<const T> element) {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            if (mClosed)
+                return nonstd::make_unexpected(IO_EOF);
+
+            if (!push(element))
+                return nonstd::make_unexpected(IO_WOULD_BLOCK);
+
+            return {};
+        }
+
+    private:
+        nonstd::expected<void, Error>
+        sendSync(std::shared_ptr<const T> element, std::optional<std::chrono::milliseconds> timeout) {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mMutex);
+
+                if (mClosed)
+                    return nonstd::make_unexpected(IO_EOF);
+
+                if (push(element))
+                    break;
+
+                zero::atomic::Event evt;
+                std::optional<aio::Error> error;
+                zero::ptr::RefPtr<ev::Event> event = getEvent();
+
+                event->on(ev::WRITE, timeout)->then([&](short what) {
+                    if (what & ev::CLOSED)
+                        error = IO_EOF;
+                    else if (what & ev::TIMEOUT)
+                        error = IO_TIMEOUT;
+
+                    evt.notify();
+                });
+
+                mPending[SENDER].push_back(std::move(event));
+                lock.unlock();
+
+                evt.wait();
+
+                if (error)
+                    return nonstd::make_unexpected(*error);
+            }
+
+            return {};
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<void>>
+        send(std::shared_ptr<const T> element, std::optional<std::chrono::milliseconds> timeout) {
+            this->addRef();
+
+            return zero::async::promise::loop<void>([=](const auto &loop) {
+                std::optional<zero::async::promise::Reason> reason;
+
+                {
+                    std::lock_guard<std::mutex> guard(mMutex);
+
+                    if (mClosed) {
+                        reason = {IO_EOF, "broadcast closed on send"};
+                    } else if (!push(element)) {
+                        zero::ptr::RefPtr<ev::Event> event = getEvent();
+
+                        event->on(ev::WRITE, timeout)->then([=](short what) {
+                            if (what & ev::CLOSED) {
+                                P_BREAK_E(loop, { IO_EOF, "broadcast closed while waiting to send" });
+                                return;
+                            } else if (what & ev::TIMEOUT) {
+                                P_BREAK_E(loop, { IO_TIMEOUT, "broadcast send timed out" });
+                                return;
+                            }
+
+                            P_CONTINUE(loop);
+                        });
+
+                        mPending[SENDER].push_back(std::move(event));
+                        return;
+                    }
+                }
+
+                if (reason) {
+                    P_BREAK_E(loop, *reason);
+                    return;
+                }
+
+                P_BREAK(loop);
+            })->finally([=]() {
+                this->release();
+            });
+        }
+
+    private:
+        nonstd::expected<std::shared_ptr<const T>, Error> tryReceive(Subscriber<T, N> *subscriber) {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            if (subscriber->mDisconnected)
+                return nonstd::make_unexpected(IO_LAGGED);
+
+            if (subscriber->mCursor == mHead)
+                return nonstd::make_unexpected(mClosed ? IO_EOF : IO_WOULD_BLOCK);
+
+            return pop(subscriber);
+        }
+
+        nonstd::expected<std::shared_ptr<const T>, Error>
+        receiveSync(Subscriber<T, N> *subscriber, std::optional<std::chrono::milliseconds> timeout) {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mMutex);
+
+                if (subscriber->mDisconnected)
+                    return nonstd::make_unexpected(IO_LAGGED);
+
+                if (subscriber->mCursor != mHead)
+                    return pop(subscriber);
+
+                if (mClosed)
+                    return nonstd::make_unexpected(IO_EOF);
+
+                zero::atomic::Event evt;
+                std::optional<aio::Error> error;
+                zero::ptr::RefPtr<ev::Event> event = getEvent();
+
+                event->on(ev::READ, timeout)->then([&](short what) {
+                    if (what & ev::CLOSED)
+                        error = IO_EOF;
+                    else if (what & ev::TIMEOUT)
+                        error = IO_TIMEOUT;
+
+                    evt.notify();
+                });
+
+                mPending[RECEIVER].push_back(std::move(event));
+                lock.unlock();
+
+                evt.wait();
+
+                if (error)
+                    return nonstd::make_unexpected(*error);
+            }
+        }
+
+        std::shared_ptr<zero::async::promise::Promise<std::shared_ptr<const T>>>
+        receive(Subscriber<T, N> *subscriber, std::optional<std::chrono::milliseconds> timeout) {
+            zero::ptr::RefPtr<Subscriber<T, N>> ref(subscriber);
+
+            return zero::async::promise::loop<std::shared_ptr<const T>>([=](const auto &loop) {
+                std::optional<zero::async::promise::Reason> reason;
+                std::shared_ptr<const T> element;
+
+                {
+                    std::lock_guard<std::mutex> guard(mMutex);
+
+                    if (ref->mDisconnected) {
+                        reason = {IO_LAGGED, "subscriber lagged behind and was disconnected"};
+                    } else if (ref->mCursor != mHead) {
+                        element = pop(ref.get());
+                    } else if (mClosed) {
+                        reason = {IO_EOF, "broadcast closed on receive"};
+                    } else {
+                        zero::ptr::RefPtr<ev::Event> event = getEvent();
+
+                        event->on(ev::READ, timeout)->then([=](short what) {
+                            if (what & ev::CLOSED) {
+                                P_BREAK_E(loop, { IO_EOF, "broadcast closed while waiting to receive" });
+                                return;
+                            } else if (what & ev::TIMEOUT) {
+                                P_BREAK_E(loop, { IO_TIMEOUT, "broadcast receive timed out" });
+                                return;
+                            }
+
+                            P_CONTINUE(loop);
+                        });
+
+                        mPending[RECEIVER].push_back(std::move(event));
+                        return;
+                    }
+                }
+
+                if (reason) {
+                    P_BREAK_E(loop, *reason);
+                    return;
+                }
+
+                P_BREAK_V(loop, std::move(element));
+            });
+        }
+
+    public:
+        void close() override {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            if (mClosed)
+                return;
+
+            mClosed = true;
+
+            trigger<SENDER>(ev::CLOSED);
+            trigger<RECEIVER>(ev::CLOSED);
+        }
+
+    private:
+        void unsubscribe(Subscriber<T, N> *subscriber) {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            mSubscribers.remove(subscriber);
+            trigger<SENDER>(ev::WRITE);
+        }
+
+        // must be called with mutex held, returns false if the slowest subscriber blocks the sender.
+        bool push(const std::shared_ptr<const T> &element) {
+            if (mHead >= N) {
+                size_t oldest = mHead - N;
+
+                auto it = std::find_if(mSubscribers.begin(), mSubscribers.end(), [=](const auto &subscriber) {
+                    return !subscriber->mDisconnected && subscriber->mCursor == oldest;
+                });
+
+                if (it != mSubscribers.end()) {
+                    if (mPolicy == BLOCK_SENDER)
+                        return false;
+
+                    for (const auto &subscriber: mSubscribers) {
+                        if (subscriber->mDisconnected || subscriber->mCursor != oldest)
+                            continue;
+
+                        if (mPolicy == DROP_OLDEST) {
+                            subscriber->mCursor++;
+                            subscriber->mDropped++;
+                            continue;
+                        }
+
+                        subscriber->mDisconnected = true;
+                    }
+                }
+            }
+
+            mRing[mHead++ % N] = element;
+            trigger<RECEIVER>(ev::READ);
+
+            return true;
+        }
+
+        std::shared_ptr<const T> pop(Subscriber<T, N> *subscriber) {
+            std::shared_ptr<const T> element = mRing[subscriber->mCursor++ % N];
+            trigger<SENDER>(ev::WRITE);
+
+            return element;
+        }
+
+        template<int Index>
+        void trigger(short what) {
+            if (mPending[Index].empty())
+                return;
+
+            mContext->post([=, pending = mPending[Index]]() {
+                for (const auto &event: pending) {
+                    if (!event->pending())
+                        continue;
+
+                    event->trigger(what);
+                }
+            });
+
+            mPending[Index].clear();
+        }
+
+        zero::ptr::RefPtr<ev::Event> getEvent() {
+            auto it = std::find_if(mEvents.begin(), mEvents.end(), [](const auto &event) {
+                return event.useCount() == 1;
+            });
+
+            if (it == mEvents.end()) {
+                mEvents.push_back(zero::ptr::makeRef<ev::Event>(mContext, -1));
+                return mEvents.back();
+            }
+
+            return *it;
+        }
+
+    private:
+        std::mutex mMutex;
+        bool mClosed;
+        size_t mHead;
+        LagPolicy mPolicy;
+        std::shared_ptr<Context> mContext;
+        std::array<std::shared_ptr<const T>, N> mRing;
+        std::list<Subscriber<T, N> *> mSubscribers;
+        std::list<zero::ptr::RefPtr<ev::Event>> mEvents;
+        std::list<zero::ptr::RefPtr<ev::Event>> mPending[2];
+
+        friend class Subscriber<T, N>;
+
+        template<typename Broadcast, typename ...Args>
+        friend zero::ptr::RefPtr<Broadcast> zero::ptr::makeRef(Args &&... args);
+    };
+}
+
+#endif //AIO_BROADCAST_H
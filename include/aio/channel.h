@@ -12,6 +12,16 @@
 #include <zero/atomic/circular_buffer.h>
 
 namespace aio {
+    struct ChannelMetrics {
+        size_t depth;
+        size_t highWatermark;
+        size_t sends;
+        size_t receives;
+        size_t timeouts;
+        std::chrono::nanoseconds senderBlocked;
+        std::chrono::nanoseconds receiverWaited;
+    };
+
     template<typename T>
     class ISender : public virtual zero::ptr::RefCounter {
     public:
@@ -60,7 +70,9 @@ namespace aio {
         static constexpr auto RECEIVER = 1;
 
     private:
-        explicit Channel(std::shared_ptr<Context> context) : mClosed(false), mContext(std::move(context)) {
+        explicit Channel(std::shared_ptr<Context> context, bool metrics = false)
+                : mClosed(false), mContext(std::move(context)),
+                  mCounters(metrics ? std::make_unique<Counters>() : nullptr) {
 
         }
 
@@ -141,6 +153,7 @@ namespace aio {
                 return nonstd::make_unexpected(IO_WOULD_BLOCK);
 
             mBuffer[*index] = std::move(element);
+            onCommitted();
             mBuffer.commit(*index);
 
             std::lock_guard<std::mutex> guard(mMutex);
@@ -157,6 +170,7 @@ namespace aio {
 
             T element = std::move(mBuffer[*index]);
             mBuffer.release(*index);
+            onReleased();
 
             std::lock_guard<std::mutex> guard(mMutex);
 
@@ -201,7 +215,9 @@ namespace aio {
                     mPending[SENDER].push_back(std::move(event));
                     mMutex.unlock();
 
+                    auto start = std::chrono::steady_clock::now();
                     evt.wait();
+                    onWaited<SENDER>(start, error == IO_TIMEOUT);
 
                     if (error)
                         return nonstd::make_unexpected(*error);
@@ -210,6 +226,7 @@ namespace aio {
                 }
 
                 mBuffer[*index] = std::move(element);
+                onCommitted();
                 mBuffer.commit(*index);
 
                 std::lock_guard<std::mutex> guard(mMutex);
@@ -226,6 +243,9 @@ namespace aio {
             if (mClosed)
                 return zero::async::promise::reject<void>({IO_EOF, "send on closed channel"});
 
+            if (trySend(std::move(element)))
+                return zero::async::promise::resolve<void>();
+
             this->addRef();
 
             return zero::async::promise::loop<void>(
@@ -245,9 +265,12 @@ namespace aio {
                                 return;
                             }
 
+                            auto start = std::chrono::steady_clock::now();
                             zero::ptr::RefPtr<ev::Event> event = getEvent();
 
                             event->on(ev::WRITE, timeout)->then([=](short what) {
+                                onWaited<SENDER>(start, what & ev::TIMEOUT);
+
                                 if (what & ev::CLOSED) {
                                     P_BREAK_E(loop, { IO_EOF, "channel closed while waiting to send" });
                                     return;
@@ -264,6 +287,7 @@ namespace aio {
                         }
 
                         mBuffer[*index] = std::move(element);
+                        onCommitted();
                         mBuffer.commit(*index);
 
                         std::lock_guard<std::mutex> guard(mMutex);
@@ -312,7 +336,9 @@ namespace aio {
                     mPending[RECEIVER].push_back(std::move(event));
                     mMutex.unlock();
 
+                    auto start = std::chrono::steady_clock::now();
                     evt.wait();
+                    onWaited<RECEIVER>(start, error == IO_TIMEOUT);
 
                     if (error)
                         return nonstd::make_unexpected(*error);
@@ -322,6 +348,7 @@ namespace aio {
 
                 element = std::move(mBuffer[*index]);
                 mBuffer.release(*index);
+                onReleased();
 
                 std::lock_guard<std::mutex> guard(mMutex);
 
@@ -333,6 +360,11 @@ namespace aio {
         }
 
         std::shared_ptr<zero::async::promise::Promise<T>> receive(std::optional<std::chrono::milliseconds> timeout) {
+            nonstd::expected<T, Error> element = tryReceive();
+
+            if (element)
+                return zero::async::promise::resolve<T>(std::move(*element));
+
             this->addRef();
 
             return zero::async::promise::loop<T>([=](const auto &loop) {
@@ -351,9 +383,12 @@ namespace aio {
                         return;
                     }
 
+                    auto start = std::chrono::steady_clock::now();
                     zero::ptr::RefPtr<ev::Event> event = getEvent();
 
                     event->on(ev::READ, timeout)->then([=](short what) {
+                        onWaited<RECEIVER>(start, what & ev::TIMEOUT);
+
                         if (what & ev::CLOSED) {
                             P_BREAK_E(loop, { IO_EOF, "channel closed while waiting to receive" });
                             return;
@@ -371,6 +406,7 @@ namespace aio {
 
                 T element = std::move(mBuffer[*index]);
                 mBuffer.release(*index);
+                onReleased();
 
                 std::lock_guard<std::mutex> guard(mMutex);
 
@@ -381,6 +417,22 @@ namespace aio {
             });
         }
 
+    public:
+        std::optional<ChannelMetrics> metrics() {
+            if (!mCounters)
+                return std::nullopt;
+
+            return ChannelMetrics{
+                    mCounters->depth,
+                    mCounters->highWatermark,
+                    mCounters->sends,
+                    mCounters->receives,
+                    mCounters->timeouts,
+                    std::chrono::nanoseconds{mCounters->senderBlocked},
+                    std::chrono::nanoseconds{mCounters->receiverWaited}
+            };
+        }
+
     public:
         void close() override {
             std::lock_guard<std::mutex> guard(mMutex);
@@ -412,6 +464,42 @@ namespace aio {
             mPending[Index].clear();
         }
 
+        void onCommitted() {
+            if (!mCounters)
+                return;
+
+            mCounters->sends++;
+
+            size_t depth = ++mCounters->depth;
+            size_t watermark = mCounters->highWatermark;
+
+            while (depth > watermark && !mCounters->highWatermark.compare_exchange_weak(watermark, depth));
+        }
+
+        void onReleased() {
+            if (!mCounters)
+                return;
+
+            mCounters->receives++;
+            mCounters->depth--;
+        }
+
+        template<int Index>
+        void onWaited(std::chrono::steady_clock::time_point start, bool timeout) {
+            if (!mCounters)
+                return;
+
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+            if constexpr (Index == SENDER)
+                mCounters->senderBlocked += elapsed.count();
+            else
+                mCounters->receiverWaited += elapsed.count();
+
+            if (timeout)
+                mCounters->timeouts++;
+        }
+
         zero::ptr::RefPtr<ev::Event> getEvent() {
             auto it = std::find_if(mEvents.begin(), mEvents.end(), [](const auto &event) {
                 return event.useCount() == 1;
@@ -425,6 +513,17 @@ namespace aio {
             return *it;
         }
 
+    private:
+        struct Counters {
+            std::atomic<size_t> depth;
+            std::atomic<size_t> highWatermark;
+            std::atomic<size_t> sends;
+            std::atomic<size_t> receives;
+            std::atomic<size_t> timeouts;
+            std::atomic<std::chrono::nanoseconds::rep> senderBlocked;
+            std::atomic<std::chrono::nanoseconds::rep> receiverWaited;
+        };
+
     private:
         std::mutex mMutex;
         std::atomic<bool> mClosed;
@@ -432,6 +531,7 @@ namespace aio {
         zero::atomic::CircularBuffer<T, N> mBuffer;
         std::list<zero::ptr::RefPtr<ev::Event>> mEvents;
         std::list<zero::ptr::RefPtr<ev::Event>> mPending[2];
+        std::unique_ptr<Counters> mCounters;
 
         template<typename Channel, typename ...Args>
         friend zero::ptr::RefPtr<Channel> zero::ptr::makeRef(Args &&... args);
@@ -7,6 +7,10 @@
 #include <zero/async/promise.h>
 
 namespace aio {
+    namespace net::dns {
+        class Cache;
+    }
+
     class Context {
     public:
         Context(event_base *base, evdns_base *dnsBase, size_t maxWorkers);
@@ -23,6 +27,10 @@ namespace aio {
     public:
         bool addNameserver(const char *ip);
 
+    public:
+        std::shared_ptr<net::dns::Cache> dnsCache();
+        void setDnsCache(std::shared_ptr<net::dns::Cache> cache);
+
     public:
         void dispatch();
         void loopBreak();
@@ -52,6 +60,7 @@ namespace aio {
         size_t mMaxWorkers;
         event_base *mBase;
         evdns_base *mDnsBase;
+        std::shared_ptr<net::dns::Cache> mDnsCache;
         std::queue<std::shared_ptr<Worker>> mWorkers;
 
         template<typename T, typename F>
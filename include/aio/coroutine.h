@@ -0,0 +1,448 @@
+#ifndef AIO_COROUTINE_H
+#define AIO_COROUTINE_H
+
+#if __cplusplus < 202002L && (!defined(_MSVC_LANG) || _MSVC_LANG < 202002L)
+#error "aio coroutine support requires C++20"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <aio/ev/buffer.h>
+#include <zero/async/promise.h>
+#include <zero/ptr/ref.h>
+
+namespace aio::coroutine {
+    template<typename T>
+    using Result = nonstd::expected<T, zero::async::promise::Reason>;
+
+    template<typename T>
+    class PromiseAwaiter {
+    public:
+        explicit PromiseAwaiter(std::shared_ptr<zero::async::promise::Promise<T>> promise)
+                : mPromise(std::move(promise)) {
+
+        }
+
+        PromiseAwaiter(PromiseAwaiter &&rhs) noexcept
+                : mResult(std::move(rhs.mResult)), mPromise(std::move(rhs.mPromise)) {
+
+        }
+
+    public:
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            // the coroutine may be resumed and destroyed inside then, so the promise must outlive this awaiter.
+            std::shared_ptr<zero::async::promise::Promise<T>> promise = std::move(mPromise);
+
+            // whichever of then and the callback finishes second owns the continuation, so a settled promise
+            // continues inline instead of nesting handle.resume() inside this call.
+            if constexpr (std::is_void_v<T>) {
+                promise->then([this, handle]() {
+                    mResult.emplace();
+
+                    if (mSettled.exchange(true))
+                        handle.resume();
+                }, [this, handle](const zero::async::promise::Reason &reason) {
+                    mResult.emplace(nonstd::make_unexpected(reason));
+
+                    if (mSettled.exchange(true))
+                        handle.resume();
+                });
+            } else {
+                promise->then([this, handle](const T &value) {
+                    mResult.emplace(value);
+
+                    if (mSettled.exchange(true))
+                        handle.resume();
+                }, [this, handle](const zero::async::promise::Reason &reason) {
+                    mResult.emplace(nonstd::make_unexpected(reason));
+
+                    if (mSettled.exchange(true))
+                        handle.resume();
+                });
+            }
+
+            return !mSettled.exchange(true);
+        }
+
+        Result<T> await_resume() {
+            return std::move(*mResult);
+        }
+
+    private:
+        std::atomic<bool> mSettled{false};
+        std::optional<Result<T>> mResult;
+        std::shared_ptr<zero::async::promise::Promise<T>> mPromise;
+    };
+
+    template<typename T>
+    class Task;
+
+    template<typename T>
+    class TaskPromise {
+    public:
+        Task<T> get_return_object() {
+            return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        auto final_suspend() noexcept {
+            struct Awaiter {
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<TaskPromise> handle) noexcept {
+                    TaskPromise &promise = handle.promise();
+                    std::coroutine_handle<> continuation = promise.mContinuation;
+
+                    if (--promise.mReferences == 0) {
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+
+                    if (!continuation)
+                        return std::noop_coroutine();
+
+                    return continuation;
+                }
+
+                void await_resume() noexcept {
+
+                }
+            };
+
+            return Awaiter{};
+        }
+
+        void return_value(Result<T> result) {
+            mResult.emplace(std::move(result));
+        }
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+
+    public:
+        template<typename U>
+        PromiseAwaiter<U> await_transform(std::shared_ptr<zero::async::promise::Promise<U>> promise) {
+            return PromiseAwaiter<U>(std::move(promise));
+        }
+
+        template<typename Awaitable>
+        Awaitable &&await_transform(Awaitable &&awaitable) {
+            return std::forward<Awaitable>(awaitable);
+        }
+
+    private:
+        int mReferences{2};
+        std::optional<Result<T>> mResult;
+        std::coroutine_handle<> mContinuation;
+
+        friend class Task<T>;
+    };
+
+    template<typename T>
+    class Task {
+    public:
+        using promise_type = TaskPromise<T>;
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle) : mHandle(handle) {
+
+        }
+
+    public:
+        Task(const Task &) = delete;
+
+        Task(Task &&rhs) noexcept: mHandle(std::exchange(rhs.mHandle, nullptr)) {
+
+        }
+
+        ~Task() {
+            if (!mHandle)
+                return;
+
+            if (--mHandle.promise().mReferences == 0)
+                mHandle.destroy();
+        }
+
+    public:
+        Task &operator=(const Task &) = delete;
+
+    public:
+        [[nodiscard]] bool done() const {
+            return mHandle.done();
+        }
+
+    public:
+        auto operator co_await() const noexcept {
+            struct Awaiter {
+                bool await_ready() noexcept {
+                    return handle.done();
+                }
+
+                void await_suspend(std::coroutine_handle<> continuation) noexcept {
+                    handle.promise().mContinuation = continuation;
+                }
+
+                Result<T> await_resume() {
+                    return std::move(*handle.promise().mResult);
+                }
+
+                std::coroutine_handle<promise_type> handle;
+            };
+
+            return Awaiter{mHandle};
+        }
+
+    private:
+        std::coroutine_handle<promise_type> mHandle;
+
+        friend class TaskPromise<T>;
+    };
+
+    namespace detail {
+        struct Detached {
+            struct promise_type {
+                Detached get_return_object() {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() noexcept {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() noexcept {
+                    return {};
+                }
+
+                void return_void() {
+
+                }
+
+                void unhandled_exception() {
+                    std::terminate();
+                }
+            };
+        };
+    }
+
+    template<typename T>
+    std::shared_ptr<zero::async::promise::Promise<T>> toPromise(Task<T> task) {
+        return zero::async::promise::chain<T>([task = std::make_shared<Task<T>>(std::move(task))](const auto &p) {
+            [](
+                    std::shared_ptr<Task<T>> task,
+                    std::shared_ptr<zero::async::promise::Promise<T>> p
+            ) -> detail::Detached {
+                Result<T> result = co_await *task;
+
+                if (!result) {
+                    p->reject(result.error());
+                    co_return;
+                }
+
+                if constexpr (std::is_void_v<T>)
+                    p->resolve();
+                else
+                    p->resolve(std::move(*result));
+            }(task, p);
+        });
+    }
+
+    class Sleep {
+    public:
+        Sleep(std::shared_ptr<Context> context, std::chrono::milliseconds delay)
+                : mContext(std::move(context)), mDelay(delay) {
+
+        }
+
+    public:
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            timeval tv = {
+                    (long) (mDelay.count() / 1000),
+                    (long) ((mDelay.count() % 1000) * 1000)
+            };
+
+            if (event_base_once(
+                    mContext->base(),
+                    -1,
+                    EV_TIMEOUT,
+                    [](evutil_socket_t, short, void *arg) {
+                        std::coroutine_handle<>::from_address(arg).resume();
+                    },
+                    handle.address(),
+                    &tv
+            ) == 0)
+                return true;
+
+            mResult = nonstd::make_unexpected(zero::async::promise::Reason{IO_ERROR, "add timer event failed"});
+            return false;
+        }
+
+        Result<void> await_resume() {
+            return mResult;
+        }
+
+    private:
+        Result<void> mResult;
+        std::shared_ptr<Context> mContext;
+        std::chrono::milliseconds mDelay;
+    };
+
+    class Poll {
+    public:
+        Poll(
+                std::shared_ptr<Context> context,
+                evutil_socket_t fd,
+                short events,
+                std::optional<std::chrono::milliseconds> timeout
+        ) : mContext(std::move(context)), mFD(fd), mEvents(events), mTimeout(timeout), mHandle(nullptr) {
+
+        }
+
+    public:
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            mHandle = handle;
+
+            std::optional<timeval> tv;
+
+            if (mTimeout)
+                tv = timeval{
+                        (long) (mTimeout->count() / 1000),
+                        (long) ((mTimeout->count() % 1000) * 1000)
+                };
+
+            if (event_base_once(
+                    mContext->base(),
+                    mFD,
+                    mEvents,
+                    [](evutil_socket_t, short what, void *arg) {
+                        auto poll = (Poll *) arg;
+
+                        poll->mResult = what;
+                        poll->mHandle.resume();
+                    },
+                    this,
+                    tv ? &*tv : nullptr
+            ) == 0)
+                return true;
+
+            mResult = nonstd::make_unexpected(zero::async::promise::Reason{IO_ERROR, "add poll event failed"});
+            return false;
+        }
+
+        Result<short> await_resume() {
+            return mResult;
+        }
+
+    private:
+        Result<short> mResult;
+        std::shared_ptr<Context> mContext;
+        evutil_socket_t mFD;
+        short mEvents;
+        std::optional<std::chrono::milliseconds> mTimeout;
+        std::coroutine_handle<> mHandle;
+    };
+
+    template<typename T, typename F>
+    class ReadyAwaiter {
+    public:
+        ReadyAwaiter(nonstd::expected<T, Error> ready, F fallback)
+                : mReady(std::move(ready)), mFallback(std::move(fallback)) {
+
+        }
+
+    public:
+        bool await_ready() {
+            return mReady.has_value();
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            mAwaiter.emplace(mFallback());
+            return mAwaiter->await_suspend(handle);
+        }
+
+        Result<T> await_resume() {
+            if (mAwaiter)
+                return mAwaiter->await_resume();
+
+            return std::move(*mReady);
+        }
+
+    private:
+        nonstd::expected<T, Error> mReady;
+        F mFallback;
+        std::optional<PromiseAwaiter<T>> mAwaiter;
+    };
+
+    template<typename T, typename F>
+    ReadyAwaiter<T, F> ready(nonstd::expected<T, Error> result, F fallback) {
+        return {std::move(result), std::move(fallback)};
+    }
+
+    inline Sleep sleep(const std::shared_ptr<Context> &context, std::chrono::milliseconds delay) {
+        return {context, delay};
+    }
+
+    inline Poll poll(
+            const std::shared_ptr<Context> &context,
+            evutil_socket_t fd,
+            short events,
+            std::optional<std::chrono::milliseconds> timeout = std::nullopt
+    ) {
+        return {context, fd, events, timeout};
+    }
+
+    template<typename Receiver>
+    auto receive(const zero::ptr::RefPtr<Receiver> &receiver) {
+        return ready(receiver->tryReceive(), [=]() {
+            return receiver->receive();
+        });
+    }
+
+    template<typename Reader>
+    auto read(const zero::ptr::RefPtr<Reader> &reader, size_t n) {
+        return ready(reader->tryRead(n), [=]() {
+            return reader->read(n);
+        });
+    }
+
+    template<typename Reader>
+    auto readLine(const zero::ptr::RefPtr<Reader> &reader, ev::EOL eol = ev::CRLF) {
+        return ready(reader->tryReadLine(eol), [=]() {
+            return reader->readLine(eol);
+        });
+    }
+
+    template<typename Reader>
+    auto peek(const zero::ptr::RefPtr<Reader> &reader, size_t n) {
+        return ready(reader->tryPeek(n), [=]() {
+            return reader->peek(n);
+        });
+    }
+
+    template<typename Reader>
+    auto readExactly(const zero::ptr::RefPtr<Reader> &reader, size_t n) {
+        return ready(reader->tryReadExactly(n), [=]() {
+            return reader->readExactly(n);
+        });
+    }
+}
+
+#endif //AIO_COROUTINE_H
@@ -23,7 +23,9 @@ namespace aio {
         WS_HANDSHAKE_ERROR,
         WS_UNCONNECTED,
         WS_UNEXPECTED_OPCODE,
-        WS_NO_FEATURE
+        WS_NO_FEATURE,
+        IO_LAGGED,
+        IO_NOT_SUPPORTED
     };
 
     std::string lastError();
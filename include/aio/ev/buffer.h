@@ -19,6 +19,14 @@ namespace aio::ev {
         virtual std::shared_ptr<zero::async::promise::Promise<std::string>> readLine(EOL eol) = 0;
         virtual std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> peek(size_t n) = 0;
         virtual std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> readExactly(size_t n) = 0;
+
+    public:
+        virtual nonstd::expected<size_t, Error> tryRead(nonstd::span<std::byte> buffer) = 0;
+        virtual nonstd::expected<std::vector<std::byte>, Error> tryRead(size_t n) = 0;
+        virtual nonstd::expected<std::string, Error> tryReadLine() = 0;
+        virtual nonstd::expected<std::string, Error> tryReadLine(EOL eol) = 0;
+        virtual nonstd::expected<std::vector<std::byte>, Error> tryPeek(size_t n) = 0;
+        virtual nonstd::expected<std::vector<std::byte>, Error> tryReadExactly(size_t n) = 0;
     };
 
     class IBufferWriter : public virtual IWriter {
@@ -59,6 +67,14 @@ namespace aio::ev {
         std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> peek(size_t n) override;
         std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> readExactly(size_t n) override;
 
+    public:
+        nonstd::expected<size_t, Error> tryRead(nonstd::span<std::byte> buffer) override;
+        nonstd::expected<std::vector<std::byte>, Error> tryRead(size_t n) override;
+        nonstd::expected<std::string, Error> tryReadLine() override;
+        nonstd::expected<std::string, Error> tryReadLine(EOL eol) override;
+        nonstd::expected<std::vector<std::byte>, Error> tryPeek(size_t n) override;
+        nonstd::expected<std::vector<std::byte>, Error> tryReadExactly(size_t n) override;
+
     public:
         nonstd::expected<void, Error> writeLine(std::string_view line) override;
         nonstd::expected<void, Error> writeLine(std::string_view line, EOL eol) override;
@@ -81,6 +97,7 @@ namespace aio::ev {
         void setTimeout(std::chrono::milliseconds readTimeout, std::chrono::milliseconds writeTimeout) override;
 
     private:
+        nonstd::expected<evbuffer *, Error> readable();
         void onClose(const zero::async::promise::Reason& reason);
 
     private:
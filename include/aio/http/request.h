@@ -7,6 +7,7 @@
 #include <aio/ev/timer.h>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <variant>
 #include <filesystem>
 #include <algorithm>
@@ -20,9 +21,40 @@
 namespace aio::http {
     using namespace std::chrono_literals;
 
+    constexpr auto MAX_IDLE_HANDLES = 64;
+    constexpr auto MAX_BODY_RESERVE = 16 * 1024 * 1024;
+
+    class HandlePool {
+    public:
+        explicit HandlePool(size_t maxSize);
+        HandlePool(const HandlePool &) = delete;
+        ~HandlePool();
+
+    public:
+        HandlePool &operator=(const HandlePool &) = delete;
+
+    public:
+        CURL *acquire();
+        void recycle(CURL *easy);
+        size_t idle();
+
+    private:
+        size_t mMaxSize;
+        std::list<CURL *> mHandles;
+    };
+
+    using Sink = std::function<nonstd::expected<void, Error>(nonstd::span<const std::byte>)>;
+
+    class Requests;
+
     class Response : public ev::IBufferReader {
     private:
-        Response(CURL *easy, zero::ptr::RefPtr<ev::IBufferReader> buffer);
+        Response(
+                CURL *easy,
+                zero::ptr::RefPtr<ev::IBufferReader> buffer,
+                std::weak_ptr<HandlePool> pool,
+                bool buffered
+        );
 
     public:
         Response(const Response &) = delete;
@@ -48,6 +80,19 @@ namespace aio::http {
         std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> peek(size_t n) override;
         std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> readExactly(size_t n) override;
 
+    public:
+        nonstd::expected<size_t, Error> tryRead(nonstd::span<std::byte> buffer) override;
+        nonstd::expected<std::vector<std::byte>, Error> tryRead(size_t n) override;
+        nonstd::expected<std::string, Error> tryReadLine() override;
+        nonstd::expected<std::string, Error> tryReadLine(ev::EOL eol) override;
+        nonstd::expected<std::vector<std::byte>, Error> tryPeek(size_t n) override;
+        nonstd::expected<std::vector<std::byte>, Error> tryReadExactly(size_t n) override;
+
+    public:
+        void resume();
+        std::shared_ptr<zero::async::promise::Promise<void>> done();
+        std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> body();
+
     public:
         std::shared_ptr<zero::async::promise::Promise<std::string>> string();
         std::shared_ptr<zero::async::promise::Promise<void>> output(const std::filesystem::path &path);
@@ -69,10 +114,19 @@ namespace aio::http {
             });
         }
 
+    private:
+        nonstd::expected<void, Error> append(nonstd::span<const std::byte> data);
+
     private:
         CURL *mEasy;
+        bool mBuffered;
         zero::ptr::RefPtr<ev::IBufferReader> mBuffer;
+        std::weak_ptr<HandlePool> mPool;
         std::map<std::string, std::string> mHeaders;
+        std::vector<std::byte> mBody;
+        std::shared_ptr<zero::async::promise::Promise<void>> mDone;
+
+        friend class Requests;
 
         template<typename T, typename ...Args>
         friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
@@ -91,6 +145,15 @@ namespace aio::http {
         std::list<std::function<void(void)>> defers;
         char error[CURL_ERROR_SIZE];
         bool transferring;
+        Sink sink;
+    };
+
+    enum Version : long {
+        HTTP_VERSION_1_0 = CURL_HTTP_VERSION_1_0,
+        HTTP_VERSION_1_1 = CURL_HTTP_VERSION_1_1,
+        HTTP_VERSION_2 = CURL_HTTP_VERSION_2_0,
+        HTTP_VERSION_2_TLS = CURL_HTTP_VERSION_2TLS,
+        HTTP_VERSION_2_PRIOR_KNOWLEDGE = CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE
     };
 
     struct Options {
@@ -99,12 +162,54 @@ namespace aio::http {
         std::map<std::string, std::string> cookies;
         std::optional<std::chrono::seconds> timeout;
         std::optional<std::string> userAgent;
+        std::optional<Version> version;
+        std::optional<std::chrono::seconds> keepAlive;
+        Sink sink;
+        bool buffered;
+    };
+
+    class Share {
+    public:
+        explicit Share(CURLSH *share);
+        Share(const Share &) = delete;
+        ~Share();
+
+    public:
+        Share &operator=(const Share &) = delete;
+
+    public:
+        CURLSH *handle();
+
+    private:
+        CURLSH *mShare;
+        std::array<std::mutex, CURL_LOCK_DATA_LAST> mMutexes;
+    };
+
+    std::shared_ptr<Share> newShare(bool connections = false);
+
+    struct Config {
+        bool multiplex;
+        std::optional<long> maxHostConnections;
+        std::optional<long> maxTotalConnections;
+        std::optional<long> maxConnects;
+        std::optional<long> maxConcurrentStreams;
+        std::shared_ptr<Share> share;
+        std::optional<size_t> maxIdleHandles;
+    };
+
+    struct Statistics {
+        size_t requests;
+        size_t connects;
+        size_t reused;
+        size_t reusedHandles;
+        size_t idleHandles;
     };
 
     class Requests : public zero::ptr::RefCounter {
     private:
         explicit Requests(const std::shared_ptr<Context> &context);
         Requests(const std::shared_ptr<Context> &context, Options options);
+        Requests(const std::shared_ptr<Context> &context, Options options, const Config &config);
 
     public:
         Requests(const Requests &) = delete;
@@ -131,22 +236,37 @@ namespace aio::http {
                         {INVALID_ARGUMENT, "invalid http request url"}
                 );
 
-            CURL *easy = curl_easy_init();
+            bool pooled = mHandles->idle() > 0;
+            CURL *easy = mHandles->acquire();
 
             if (!easy)
                 return zero::async::promise::reject<zero::ptr::RefPtr<Response>>(
                         {HTTP_INIT_ERROR, "create http request failed"}
                 );
 
+            if (pooled)
+                mStatistics.reusedHandles++;
+
             std::array<zero::ptr::RefPtr<ev::IPairedBuffer>, 2> buffers = ev::pipe(mContext);
 
+            Options opt = options.value_or(mOptions);
+            bool buffered = !opt.sink && opt.buffered;
+
             auto connection = new Connection{
                     easy,
-                    zero::ptr::makeRef<Response>(easy, buffers[1]),
+                    zero::ptr::makeRef<Response>(easy, buffers[1], mHandles, buffered),
                     buffers[0]
             };
 
-            Options opt = options.value_or(mOptions);
+            if (opt.sink) {
+                connection->sink = opt.sink;
+            } else if (buffered) {
+                Response *response = connection->response.get();
+
+                connection->sink = [=](nonstd::span<const std::byte> data) -> nonstd::expected<void, Error> {
+                    return response->append(data);
+                };
+            }
 
             if (method == "HEAD") {
                 curl_easy_setopt(easy, CURLOPT_NOBODY, 1L);
@@ -203,6 +323,22 @@ namespace aio::http {
                             [](char *buffer, size_t size, size_t n, void *userdata) -> size_t {
                                 auto connection = (Connection *) userdata;
 
+                                if (connection->sink) {
+                                    nonstd::expected<void, Error> result;
+
+                                    try {
+                                        result = connection->sink({(const std::byte *) buffer, size * n});
+                                    } catch (...) {
+                                        return CURL_WRITEFUNC_ERROR;
+                                    }
+
+                                    if (!result)
+                                        return result.error() == IO_WOULD_BLOCK ?
+                                               CURL_WRITEFUNC_PAUSE : CURL_WRITEFUNC_ERROR;
+
+                                    return size * n;
+                                }
+
                                 if (connection->buffer->pending() >= 1024 * 1024) {
                                     connection->buffer->drain()->finally([=]() {
                                         curl_easy_pause(connection->easy, CURLPAUSE_CONT);
@@ -249,6 +385,21 @@ namespace aio::http {
             if (opt.proxy)
                 curl_easy_setopt(easy, CURLOPT_PROXY, opt.proxy->c_str());
 
+            if (opt.version)
+                curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long) *opt.version);
+
+            if (opt.keepAlive) {
+                curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+                curl_easy_setopt(easy, CURLOPT_TCP_KEEPIDLE, (long) opt.keepAlive->count());
+                curl_easy_setopt(easy, CURLOPT_TCP_KEEPINTVL, (long) opt.keepAlive->count());
+            }
+
+            if (mConfig.multiplex)
+                curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+
+            if (mConfig.share)
+                curl_easy_setopt(easy, CURLOPT_SHARE, mConfig.share->handle());
+
             if (!opt.cookies.empty()) {
                 std::list<std::string> cookies;
 
@@ -444,10 +595,14 @@ namespace aio::http {
 
     public:
         Options &options();
+        Statistics statistics();
 
     private:
         CURLM *mMulti;
         Options mOptions;
+        Config mConfig;
+        Statistics mStatistics;
+        std::shared_ptr<HandlePool> mHandles;
         zero::ptr::RefPtr<ev::Timer> mTimer;
         std::shared_ptr<Context> mContext;
 
@@ -2,8 +2,27 @@
 #define AIO_DGRAM_H
 
 #include "net.h"
+#include <list>
+#include <unordered_map>
 
 namespace aio::net::dgram {
+    struct Datagram {
+        nonstd::span<const std::byte> data;
+        Address address;
+        SocketAddress socketAddress;
+    };
+
+    struct DatagramBatch {
+        std::shared_ptr<std::byte[]> slab;
+        std::vector<Datagram> datagrams;
+    };
+
+    struct SegmentedDatagram {
+        std::vector<std::byte> data;
+        size_t segmentSize;
+        Address address;
+    };
+
     class Socket : public ISocket {
     private:
         Socket(evutil_socket_t fd, zero::ptr::RefPtr<ev::Event> events[2]);
@@ -42,11 +61,142 @@ namespace aio::net::dgram {
                 const Address &address
         );
 
+        std::shared_ptr<zero::async::promise::Promise<void>> writeTo(
+                nonstd::span<const std::byte> buffer,
+                const SocketAddress &address
+        );
+
+    public:
+        nonstd::expected<void, Error> trySendTo(nonstd::span<const std::byte> buffer, const Address &address);
+        nonstd::expected<void, Error> trySendTo(nonstd::span<const std::byte> buffer, const SocketAddress &address);
+
+    public:
+        std::shared_ptr<zero::async::promise::Promise<DatagramBatch>> readBatch(size_t maxMessages, size_t maxSize);
+        std::shared_ptr<zero::async::promise::Promise<void>> writeBatch(nonstd::span<const Datagram> datagrams);
+
+    public:
+        nonstd::expected<void, Error> setOptions(const SocketOptions &options);
+        nonstd::expected<void, Error> setGRO(bool enable);
+        std::shared_ptr<zero::async::promise::Promise<SegmentedDatagram>> readSegments(size_t n);
+        std::shared_ptr<zero::async::promise::Promise<void>> writeSegments(
+                nonstd::span<const std::byte> buffer,
+                size_t segmentSize,
+                const Address &address
+        );
+
+    private:
+        std::shared_ptr<std::byte[]> slab(size_t size);
+
     private:
         bool mClosed;
         evutil_socket_t mFD;
         zero::ptr::RefPtr<ev::Event> mEvents[2];
         std::optional<std::chrono::milliseconds> mTimeouts[2];
+        size_t mSlabSize;
+        std::shared_ptr<std::byte[]> mSlab;
+
+        template<typename T, typename ...Args>
+        friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
+    };
+
+    class Listener;
+
+    class Session : public ISocket {
+    private:
+        Session(zero::ptr::RefPtr<Listener> listener, Address address, const SocketAddress &socketAddress);
+
+    public:
+        Session(const Session &) = delete;
+        ~Session() override;
+
+    public:
+        Session &operator=(const Session &) = delete;
+
+    public:
+        std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> read(size_t n) override;
+
+    public:
+        std::shared_ptr<zero::async::promise::Promise<void>> write(nonstd::span<const std::byte> buffer) override;
+        nonstd::expected<void, Error> close() override;
+
+    public:
+        std::optional<Address> localAddress() override;
+        std::optional<Address> remoteAddress() override;
+
+    public:
+        void setTimeout(std::chrono::milliseconds timeout) override;
+        void setTimeout(std::chrono::milliseconds readTimeout, std::chrono::milliseconds writeTimeout) override;
+
+    public:
+        evutil_socket_t fd() override;
+        bool bind(const Address &address) override;
+        std::shared_ptr<zero::async::promise::Promise<void>> connect(const Address &address) override;
+
+    private:
+        bool mClosed;
+        Address mAddress;
+        SocketAddress mSocketAddress;
+        zero::ptr::RefPtr<Listener> mListener;
+        zero::ptr::RefPtr<Channel<std::vector<std::byte>, 128>> mChannel;
+        std::optional<std::chrono::milliseconds> mTimeouts[2];
+
+        friend class Listener;
+
+        template<typename T, typename ...Args>
+        friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
+    };
+
+    class Listener : public zero::ptr::RefCounter {
+    private:
+        struct PendingWrite {
+            std::vector<std::byte> data;
+            SocketAddress address;
+            std::optional<std::chrono::steady_clock::time_point> deadline;
+            std::shared_ptr<zero::async::promise::Promise<void>> promise;
+        };
+
+    private:
+        Listener(std::shared_ptr<Context> context, zero::ptr::RefPtr<Socket> socket);
+
+    public:
+        Listener(const Listener &) = delete;
+
+    public:
+        Listener &operator=(const Listener &) = delete;
+        ~Listener() override;
+
+    public:
+        std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<Session>>> accept();
+        nonstd::expected<void, Error> close();
+
+    public:
+        std::optional<Address> localAddress();
+
+    private:
+        void receive();
+        void dispatch(const Datagram &datagram);
+        void flush();
+
+    private:
+        std::shared_ptr<zero::async::promise::Promise<void>> send(
+                nonstd::span<const std::byte> buffer,
+                const SocketAddress &address,
+                std::optional<std::chrono::milliseconds> timeout
+        );
+
+    private:
+        bool mClosed;
+        bool mReceiving;
+        bool mFlushing;
+        std::shared_ptr<Context> mContext;
+        zero::ptr::RefPtr<Socket> mSocket;
+        zero::ptr::RefPtr<ev::Event> mWritable;
+        zero::ptr::RefPtr<Channel<zero::ptr::RefPtr<Session>, 128>> mBacklog;
+        std::unordered_map<SocketAddress, Session *> mSessions;
+        std::list<PendingWrite> mWrites;
+        std::optional<zero::async::promise::Reason> mError;
+
+        friend class Session;
 
         template<typename T, typename ...Args>
         friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
@@ -72,6 +222,9 @@ namespace aio::net::dgram {
             unsigned short port
     );
 
+    zero::ptr::RefPtr<Listener> listen(const std::shared_ptr<Context> &context, const Address &address);
+    zero::ptr::RefPtr<Listener> listen(const std::shared_ptr<Context> &context, const std::string &ip, unsigned short port);
+
     zero::ptr::RefPtr<Socket> newSocket(const std::shared_ptr<Context> &context, int family);
 }
 
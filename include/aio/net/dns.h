@@ -2,8 +2,76 @@
 #define AIO_DNS_H
 
 #include "net.h"
+#include <list>
+#include <unordered_map>
 
 namespace aio::net::dns {
+    struct CacheConfig {
+        size_t maxSize;
+        std::chrono::seconds ttl;
+        std::chrono::seconds negativeTTL;
+    };
+
+    class Cache : public std::enable_shared_from_this<Cache> {
+    private:
+        struct Entry {
+            std::string key;
+            std::chrono::steady_clock::time_point expiry;
+            nonstd::expected<std::vector<Address>, zero::async::promise::Reason> result;
+        };
+
+    public:
+        explicit Cache(const CacheConfig &config);
+        Cache(const Cache &) = delete;
+
+    public:
+        Cache &operator=(const Cache &) = delete;
+
+    public:
+        std::shared_ptr<zero::async::promise::Promise<std::vector<Address>>> getAddressInfo(
+                const std::shared_ptr<Context> &context,
+                const std::string &node,
+                const std::optional<std::string> &service,
+                const std::optional<evutil_addrinfo> &hints
+        );
+
+    public:
+        size_t size() const;
+        void clear();
+
+    private:
+        std::optional<nonstd::expected<std::vector<Address>, zero::async::promise::Reason>>
+        find(const std::string &key);
+
+        void insert(
+                const std::string &key,
+                nonstd::expected<std::vector<Address>, zero::async::promise::Reason> result
+        );
+
+        void complete(
+                const std::string &key,
+                const nonstd::expected<std::vector<Address>, zero::async::promise::Reason> &result
+        );
+
+    private:
+        CacheConfig mConfig;
+        std::list<Entry> mEntries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+        std::unordered_map<
+                std::string,
+                std::list<std::shared_ptr<zero::async::promise::Promise<std::vector<Address>>>>
+        > mPending;
+    };
+
+    std::shared_ptr<Cache> newCache(const CacheConfig &config);
+
+    std::shared_ptr<zero::async::promise::Promise<std::vector<Address>>> query(
+            const std::shared_ptr<Context> &context,
+            const std::string &node,
+            const std::optional<std::string> &service,
+            const std::optional<evutil_addrinfo> &hints
+    );
+
     std::shared_ptr<zero::async::promise::Promise<std::vector<Address>>> getAddressInfo(
             const std::shared_ptr<Context> &context,
             const std::string &node,
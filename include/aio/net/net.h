@@ -2,7 +2,10 @@
 #define AIO_NET_H
 
 #include <aio/io.h>
+#include <aio/ev/timer.h>
+#include <map>
 #include <variant>
+#include <functional>
 
 namespace aio::net {
     struct IPv4Address {
@@ -22,6 +25,32 @@ namespace aio::net {
 
     using Address = std::variant<IPv4Address, IPv6Address, UnixAddress>;
 
+    struct SocketAddress {
+        sockaddr_storage storage;
+        socklen_t length;
+    };
+
+    static_assert(std::is_trivially_copyable_v<SocketAddress>);
+
+    struct KeepAlive {
+        std::chrono::seconds idle;
+        std::chrono::seconds interval;
+        int count;
+    };
+
+    struct SocketOptions {
+        std::optional<bool> noDelay;
+        std::optional<bool> quickAck;
+        std::optional<bool> cork;
+        std::optional<int> sendBuffer;
+        std::optional<int> receiveBuffer;
+        std::optional<int> notSentLowAt;
+        std::optional<std::chrono::microseconds> busyPoll;
+        std::optional<int> fastOpen;
+        std::optional<KeepAlive> keepAlive;
+        std::optional<int> incomingCPU;
+    };
+
     bool operator==(const IPv4Address &lhs, const IPv4Address &rhs);
     bool operator!=(const IPv4Address &lhs, const IPv4Address &rhs);
 
@@ -34,6 +63,9 @@ namespace aio::net {
     bool operator==(const Address &lhs, const Address &rhs);
     bool operator!=(const Address &lhs, const Address &rhs);
 
+    bool operator==(const SocketAddress &lhs, const SocketAddress &rhs);
+    bool operator!=(const SocketAddress &lhs, const SocketAddress &rhs);
+
     std::string stringify(const IPv4Address &ipv4Address);
     std::string stringify(const IPv6Address &ipv6Address);
     std::string stringify(const UnixAddress &unixAddress);
@@ -57,11 +89,23 @@ namespace aio::net {
     std::optional<Address> getSocketAddress(evutil_socket_t fd, bool peer);
 
     std::optional<Address> addressFrom(const sockaddr *storage);
+    std::optional<Address> addressFrom(const SocketAddress &socketAddress);
     std::optional<Address> IPAddressFrom(const std::string &ip, unsigned short port);
     std::optional<Address> IPv4AddressFrom(const std::string &ip, unsigned short port);
     std::optional<Address> IPv6AddressFrom(const std::string &ip, unsigned short port);
 
-    std::optional<std::vector<std::byte>> socketAddressFrom(const Address &address);
+    std::optional<SocketAddress> socketAddressFrom(const Address &address);
+    std::optional<SocketAddress> socketAddressFrom(const sockaddr *addr, socklen_t length);
+
+    nonstd::expected<void, Error> setSocketOptions(evutil_socket_t fd, const SocketOptions &options);
+
+    std::vector<Address> interleave(nonstd::span<const Address> addresses);
+
+    template<typename T>
+    struct Attempt {
+        std::shared_ptr<zero::async::promise::Promise<T>> promise;
+        std::function<void()> cancel;
+    };
 
     template<typename T, typename F, typename ...Args>
     std::shared_ptr<zero::async::promise::Promise<T>> tryAddress(
@@ -100,6 +144,123 @@ namespace aio::net {
                 }
         );
     }
+
+    constexpr auto CONNECT_ATTEMPT_DELAY = std::chrono::milliseconds{250};
+
+    template<typename T, typename F, typename ...Args>
+    std::shared_ptr<zero::async::promise::Promise<T>> raceAddress(
+            const std::shared_ptr<Context> &context,
+            nonstd::span<const Address> addresses,
+            std::chrono::milliseconds delay,
+            F &&f,
+            Args ...args
+    ) {
+        using R = std::invoke_result_t<F, const std::shared_ptr<Context> &, const Address &, Args...>;
+
+        if (addresses.empty())
+            return zero::async::promise::reject<T>({INVALID_ARGUMENT, "empty address list"});
+
+        return zero::async::promise::chain<T>([
+                =,
+                f = std::forward<F>(f),
+                addresses = interleave(addresses)
+        ](const auto &p) {
+            zero::ptr::RefPtr<ev::Timer> timer = zero::ptr::makeRef<ev::Timer>(context);
+            std::shared_ptr<size_t> index = std::make_shared<size_t>();
+            std::shared_ptr<size_t> pending = std::make_shared<size_t>();
+            std::shared_ptr<size_t> failures = std::make_shared<size_t>();
+            std::shared_ptr<bool> done = std::make_shared<bool>();
+            std::shared_ptr<zero::async::promise::Reason> tail = std::make_shared<zero::async::promise::Reason>();
+            std::shared_ptr<std::map<size_t, std::function<void()>>> inflight = std::make_shared<
+                    std::map<size_t, std::function<void()>>
+            >();
+            std::shared_ptr<std::function<void()>> attempt = std::make_shared<std::function<void()>>();
+
+            *attempt = [=, self = std::weak_ptr<std::function<void()>>(attempt)]() {
+                std::shared_ptr<std::function<void()>> attempt = self.lock();
+
+                if (!attempt || *done || *index >= addresses.size())
+                    return;
+
+                size_t id = *index;
+                const Address &address = addresses[(*index)++];
+                (*pending)++;
+
+                if (*index < addresses.size())
+                    timer->setTimeout(delay)->then([=]() {
+                        (*attempt)();
+                    });
+
+                std::shared_ptr<zero::async::promise::Promise<T>> promise;
+
+                if constexpr (std::is_same_v<R, Attempt<T>>) {
+                    Attempt<T> handle = f(context, address, args...);
+
+                    if (handle.cancel)
+                        (*inflight)[id] = std::move(handle.cancel);
+
+                    promise = std::move(handle.promise);
+                } else {
+                    promise = f(context, address, args...);
+                }
+
+                promise->then([=](const T &result) {
+                    (*pending)--;
+                    inflight->erase(id);
+
+                    if (*done)
+                        return;
+
+                    *done = true;
+                    timer->cancel();
+
+                    std::map<size_t, std::function<void()>> losers = std::move(*inflight);
+                    inflight->clear();
+
+                    for (const auto &[i, cancel]: losers)
+                        cancel();
+
+                    p->resolve(result);
+                }, [=](const zero::async::promise::Reason &reason) {
+                    (*pending)--;
+                    inflight->erase(id);
+
+                    if (*done)
+                        return;
+
+                    zero::async::promise::Reason last = reason;
+
+                    if ((*failures)++ > 0)
+                        last.previous = std::make_shared<zero::async::promise::Reason>(*tail);
+
+                    *tail = last;
+
+                    if (*index < addresses.size()) {
+                        timer->cancel();
+                        (*attempt)();
+                        return;
+                    }
+
+                    if (*pending > 0)
+                        return;
+
+                    *done = true;
+                    p->reject(*tail);
+                });
+            };
+
+            (*attempt)();
+        });
+    }
+}
+
+namespace std {
+    template<>
+    struct hash<aio::net::SocketAddress> {
+        size_t operator()(const aio::net::SocketAddress &address) const noexcept {
+            return hash<string_view>{}({(const char *) &address.storage, (size_t) address.length});
+        }
+    };
 }
 
 #endif //AIO_NET_H
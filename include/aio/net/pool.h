@@ -0,0 +1,75 @@
+#ifndef AIO_POOL_H
+#define AIO_POOL_H
+
+#include "stream.h"
+#include <map>
+#include <list>
+
+#ifndef AIO_DISABLE_SSL
+#include "ssl.h"
+#endif
+
+namespace aio::net {
+    struct Endpoint {
+        std::string host;
+        unsigned short port;
+#ifndef AIO_DISABLE_SSL
+        std::shared_ptr<ssl::Context> ctx;
+#endif
+    };
+
+    struct PoolConfig {
+        size_t maxIdle;
+        std::chrono::milliseconds idleTimeout;
+    };
+
+    class ConnectionPool : public zero::ptr::RefCounter {
+    private:
+        struct Connection {
+            zero::ptr::RefPtr<stream::IBuffer> buffer;
+            std::chrono::steady_clock::time_point since;
+        };
+
+    private:
+        ConnectionPool(std::shared_ptr<Context> context, const PoolConfig &config);
+
+    public:
+        ConnectionPool(const ConnectionPool &) = delete;
+
+    public:
+        ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    public:
+        std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<stream::IBuffer>>>
+        acquire(const Endpoint &endpoint);
+
+        void recycle(const Endpoint &endpoint, zero::ptr::RefPtr<stream::IBuffer> buffer);
+        std::shared_ptr<zero::async::promise::Promise<void>> prewarm(const Endpoint &endpoint, size_t count);
+
+    public:
+        size_t idle(const Endpoint &endpoint);
+        void clear();
+
+    private:
+        std::string key(const Endpoint &endpoint);
+        bool healthy(const zero::ptr::RefPtr<stream::IBuffer> &buffer);
+
+        std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<stream::IBuffer>>>
+        connect(const Endpoint &endpoint);
+
+    private:
+        void sweep();
+        void schedule();
+
+    private:
+        PoolConfig mConfig;
+        std::shared_ptr<Context> mContext;
+        zero::ptr::RefPtr<ev::Timer> mTimer;
+        std::map<std::string, std::list<Connection>> mIdle;
+
+        template<typename T, typename ...Args>
+        friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
+    };
+}
+
+#endif //AIO_POOL_H
@@ -2,8 +2,14 @@
 #define AIO_SSL_H
 
 #include "stream.h"
+#include <map>
+#include <list>
+#include <mutex>
+#include <queue>
 #include <optional>
 #include <filesystem>
+#include <unordered_map>
+#include <aio/channel.h>
 #include <aio/context.h>
 #include <aio/ev/buffer.h>
 #include <openssl/ssl.h>
@@ -32,6 +38,71 @@ namespace aio::net::ssl {
         std::variant<std::monostate, std::string, std::filesystem::path> privateKey;
         bool insecure;
         bool server;
+        size_t sessionCacheSize;
+        std::optional<std::chrono::seconds> ticketKeyRotation;
+        bool ktls;
+        std::vector<std::string> alpn;
+    };
+
+    class SessionCache {
+    private:
+        struct Entry {
+            std::string host;
+            SSL_SESSION *session;
+        };
+
+    public:
+        explicit SessionCache(size_t maxSize);
+        SessionCache(const SessionCache &) = delete;
+        ~SessionCache();
+
+    public:
+        SessionCache &operator=(const SessionCache &) = delete;
+
+    public:
+        SSL_SESSION *get(const std::string &host);
+        void set(const std::string &host, SSL_SESSION *session);
+        void remove(const std::string &host);
+
+    public:
+        static int index();
+
+    private:
+        size_t mMaxSize;
+        std::mutex mMutex;
+        std::list<Entry> mEntries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+    };
+
+    struct TicketKey {
+        std::array<unsigned char, 16> name;
+        std::array<unsigned char, 32> aesKey;
+        std::array<unsigned char, 32> hmacKey;
+        std::chrono::steady_clock::time_point created;
+    };
+
+    class TicketKeyRing {
+    public:
+        explicit TicketKeyRing(std::chrono::seconds rotation);
+        TicketKeyRing(const TicketKeyRing &) = delete;
+
+    public:
+        TicketKeyRing &operator=(const TicketKeyRing &) = delete;
+
+    public:
+        std::optional<TicketKey> current();
+        std::optional<std::pair<TicketKey, bool>> find(const unsigned char *name);
+
+    public:
+        static int index();
+
+    private:
+        std::optional<TicketKey> generate();
+
+    private:
+        std::chrono::seconds mRotation;
+        std::mutex mMutex;
+        std::list<TicketKey> mKeys;
     };
 
     std::string getError();
@@ -39,7 +110,48 @@ namespace aio::net::ssl {
 
     std::shared_ptr<Context> newContext(const Config &config);
 
+    class Registry : public std::enable_shared_from_this<Registry> {
+    private:
+        struct Entry {
+            Config config;
+            std::shared_ptr<Context> ctx;
+        };
+
+    public:
+        Registry() = default;
+        Registry(const Registry &) = delete;
+
+    public:
+        Registry &operator=(const Registry &) = delete;
+
+    public:
+        std::shared_ptr<Context> get(const Config &config);
+        bool bind(const std::string &serverName, const Config &config);
+        std::shared_ptr<Context> select(const std::string &serverName);
+        std::shared_ptr<Context> server();
+
+    public:
+        bool reload();
+        void clear();
+
+    public:
+        static int index();
+
+    private:
+        static std::string key(const Config &config);
+
+    private:
+        std::mutex mMutex;
+        std::map<std::string, Entry> mContexts;
+        std::map<std::string, std::string> mServerNames;
+    };
+
+    std::shared_ptr<Registry> defaultRegistry();
+
     namespace stream {
+        constexpr auto HANDSHAKE_TIMEOUT = std::chrono::milliseconds{10000};
+        constexpr auto HANDSHAKE_CONCURRENCY = 16;
+
         class Buffer : public net::stream::Buffer {
         private:
             explicit Buffer(bufferevent *bev);
@@ -47,6 +159,15 @@ namespace aio::net::ssl {
         public:
             nonstd::expected<void, Error> close() override;
 
+        public:
+            bool alive();
+            std::optional<std::string> negotiatedProtocol();
+
+        public:
+            bool ktlsSend();
+            bool ktlsReceive();
+            std::shared_ptr<zero::async::promise::Promise<void>> sendFile(int fd, off_t offset, size_t size);
+
         private:
             std::string getError() override;
 
@@ -61,8 +182,30 @@ namespace aio::net::ssl {
         public:
             std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> accept();
 
+        public:
+            void close() override;
+            void setHandshakeOffload(
+                    std::optional<std::chrono::milliseconds> timeout,
+                    size_t concurrency = HANDSHAKE_CONCURRENCY
+            );
+
+        private:
+            void dispatch();
+            void handshake(evutil_socket_t fd, std::chrono::milliseconds timeout);
+
         private:
+            std::shared_ptr<zero::async::promise::Promise<void>> acquireSlot();
+            void releaseSlot();
+
+        private:
+            bool mDispatching;
+            size_t mOffloads;
+            size_t mConcurrency;
             std::shared_ptr<Context> mCTX;
+            std::optional<std::chrono::milliseconds> mHandshakeTimeout;
+            std::optional<zero::async::promise::Reason> mError;
+            std::queue<std::shared_ptr<zero::async::promise::Promise<void>>> mSlots;
+            zero::ptr::RefPtr<Channel<zero::ptr::RefPtr<net::stream::IBuffer>, 128>> mBacklog;
 
             template<typename T, typename ...Args>
             friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
@@ -90,7 +233,8 @@ namespace aio::net::ssl {
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
                 const std::shared_ptr<aio::Context> &context,
                 const std::string &host,
-                unsigned short port
+                unsigned short port,
+                std::chrono::milliseconds delay = CONNECT_ATTEMPT_DELAY
         );
 
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
@@ -100,26 +244,43 @@ namespace aio::net::ssl {
 
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
                 const std::shared_ptr<aio::Context> &context,
-                nonstd::span<const Address> addresses
+                nonstd::span<const Address> addresses,
+                std::chrono::milliseconds delay = CONNECT_ATTEMPT_DELAY
         );
 
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
                 const std::shared_ptr<aio::Context> &context,
                 const std::string &host,
                 unsigned short port,
+                const std::shared_ptr<Context> &ctx,
+                std::chrono::milliseconds delay = CONNECT_ATTEMPT_DELAY
+        );
+
+        std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
+                const std::shared_ptr<aio::Context> &context,
+                const Address &address,
                 const std::shared_ptr<Context> &ctx
         );
 
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
                 const std::shared_ptr<aio::Context> &context,
                 const Address &address,
+                const std::string &host,
+                const std::shared_ptr<Context> &ctx
+        );
+
+        Attempt<zero::ptr::RefPtr<net::stream::IBuffer>> attempt(
+                const std::shared_ptr<aio::Context> &context,
+                const Address &address,
+                const std::string &host,
                 const std::shared_ptr<Context> &ctx
         );
 
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<net::stream::IBuffer>>> connect(
                 const std::shared_ptr<aio::Context> &context,
                 nonstd::span<const Address> addresses,
-                const std::shared_ptr<Context> &ctx
+                const std::shared_ptr<Context> &ctx,
+                std::chrono::milliseconds delay = CONNECT_ATTEMPT_DELAY
         );
     }
 }
@@ -8,7 +8,8 @@
 
 namespace aio::net::stream {
     class IBuffer : public virtual IEndpoint, public virtual ev::IBuffer {
-
+    public:
+        virtual nonstd::expected<void, Error> setOptions(const SocketOptions &options) = 0;
     };
 
     class Buffer : public ev::Buffer, public IBuffer {
@@ -19,13 +20,20 @@ namespace aio::net::stream {
         std::optional<Address> localAddress() override;
         std::optional<Address> remoteAddress() override;
 
+    public:
+        nonstd::expected<void, Error> setOptions(const SocketOptions &options) override;
+
         template<typename T, typename ...Args>
         friend zero::ptr::RefPtr<T> zero::ptr::makeRef(Args &&... args);
     };
 
     class ListenerBase : public zero::ptr::RefCounter {
     protected:
-        ListenerBase(std::shared_ptr<Context> context, evconnlistener *listener);
+        ListenerBase(
+                std::shared_ptr<Context> context,
+                evconnlistener *listener,
+                std::optional<SocketOptions> options = std::nullopt
+        );
 
     public:
         ListenerBase(const ListenerBase &) = delete;
@@ -38,11 +46,13 @@ namespace aio::net::stream {
         std::shared_ptr<zero::async::promise::Promise<evutil_socket_t>> fd();
 
     public:
-        void close();
+        virtual void close();
+        nonstd::expected<void, Error> setOptions(const SocketOptions &options);
 
     protected:
         evconnlistener *mListener;
         std::shared_ptr<Context> mContext;
+        std::optional<SocketOptions> mOptions;
         std::shared_ptr<zero::async::promise::Promise<evutil_socket_t>> mPromise;
 
         template<typename T, typename ...Args>
@@ -51,7 +61,11 @@ namespace aio::net::stream {
 
     class Listener : public ListenerBase {
     private:
-        Listener(std::shared_ptr<Context> context, evconnlistener *listener);
+        Listener(
+                std::shared_ptr<Context> context,
+                evconnlistener *listener,
+                std::optional<SocketOptions> options = std::nullopt
+        );
 
     public:
         std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>> accept();
@@ -61,19 +75,52 @@ namespace aio::net::stream {
     };
 
     zero::ptr::RefPtr<Listener> listen(const std::shared_ptr<Context> &context, const Address &address);
+
+    zero::ptr::RefPtr<Listener> listen(
+            const std::shared_ptr<Context> &context,
+            const Address &address,
+            const SocketOptions &options
+    );
+
     zero::ptr::RefPtr<Listener> listen(const std::shared_ptr<Context> &context, nonstd::span<const Address> addresses);
 
     zero::ptr::RefPtr<Listener>
     listen(const std::shared_ptr<Context> &context, const std::string &ip, unsigned short port);
 
-    std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>>
-    connect(const std::shared_ptr<Context> &context, const Address &address);
+    zero::ptr::RefPtr<Listener> listen(
+            const std::shared_ptr<Context> &context,
+            const std::string &ip,
+            unsigned short port,
+            const SocketOptions &options
+    );
 
     std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>>
-    connect(const std::shared_ptr<Context> &context, nonstd::span<const Address> addresses);
+    connect(const std::shared_ptr<Context> &context, const Address &address);
 
-    std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>>
-    connect(const std::shared_ptr<Context> &context, const std::string &host, unsigned short port);
+    std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>> connect(
+            const std::shared_ptr<Context> &context,
+            const Address &address,
+            nonstd::span<const std::byte> data
+    );
+
+    Attempt<zero::ptr::RefPtr<IBuffer>> attempt(
+            const std::shared_ptr<Context> &context,
+            const Address &address,
+            nonstd::span<const std::byte> data
+    );
+
+    std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>> connect(
+            const std::shared_ptr<Context> &context,
+            nonstd::span<const Address> addresses,
+            std::chrono::milliseconds delay = CONNECT_ATTEMPT_DELAY
+    );
+
+    std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>> connect(
+            const std::shared_ptr<Context> &context,
+            const std::string &host,
+            unsigned short port,
+            std::chrono::milliseconds delay = CONNECT_ATTEMPT_DELAY
+    );
 
 #ifdef __unix__
     zero::ptr::RefPtr<Listener> listen(const std::shared_ptr<Context> &context, const std::string &path);
@@ -0,0 +1,109 @@
+#include <zero/log.h>
+#include <zero/cmdline.h>
+#include <aio/ev/timer.h>
+#include <aio/channel.h>
+#include <atomic>
+#include <new>
+
+static std::atomic<size_t> allocations;
+
+void *operator new(size_t size) {
+    allocations++;
+
+    void *ptr = malloc(size ? size : 1);
+
+    if (!ptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void benchmark(
+        const std::shared_ptr<aio::Context> &context,
+        const char *name,
+        size_t n,
+        const std::function<std::shared_ptr<zero::async::promise::Promise<void>>(void)> &op
+) {
+    std::shared_ptr<size_t> counter = std::make_shared<size_t>();
+
+    size_t start = allocations;
+    auto begin = std::chrono::steady_clock::now();
+
+    zero::async::promise::loop<void>([=](const auto &loop) {
+        if ((*counter)++ >= n) {
+            P_BREAK(loop);
+            return;
+        }
+
+        op()->then(
+                PF_LOOP_CONTINUE(loop),
+                PF_LOOP_THROW(loop)
+        );
+    })->fail([](const zero::async::promise::Reason &reason) {
+        LOG_ERROR("%s", reason.message.c_str());
+    })->finally([=]() {
+        context->loopBreak();
+    });
+
+    context->dispatch();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    LOG_INFO(
+            "%s: %.2f allocations/op, %.0f ops/sec",
+            name,
+            (double) (allocations - start) / (double) n,
+            (double) n / elapsed.count()
+    );
+}
+
+int main(int argc, char **argv) {
+    INIT_CONSOLE_LOG(zero::INFO_LEVEL);
+
+    zero::Cmdline cmdline;
+
+    cmdline.addOptional<size_t>("count", 'n', "operation count", 100000);
+    cmdline.parse(argc, argv);
+
+    auto count = cmdline.getOptional<size_t>("count");
+
+    std::shared_ptr<aio::Context> context = aio::newContext();
+
+    if (!context)
+        return -1;
+
+    zero::ptr::RefPtr<aio::ev::Timer> timer = zero::ptr::makeRef<aio::ev::Timer>(context);
+    zero::ptr::RefPtr<aio::ev::Event> event = zero::ptr::makeRef<aio::ev::Event>(context, -1);
+    zero::ptr::RefPtr<aio::Channel<int, 100>> channel = zero::ptr::makeRef<aio::Channel<int, 100>>(context);
+
+    benchmark(context, "timer", *count, [=]() {
+        return timer->setTimeout(std::chrono::milliseconds::zero());
+    });
+
+    benchmark(context, "event", *count, [=]() {
+        std::shared_ptr<zero::async::promise::Promise<short>> promise = event->on(aio::ev::READ);
+        event->trigger(aio::ev::READ);
+
+        return promise->then([](short) {
+
+        });
+    });
+
+    benchmark(context, "channel", *count, [=]() {
+        return channel->send(0)->then([=]() {
+            return channel->receive();
+        })->then([](int) {
+
+        });
+    });
+
+    return 0;
+}
@@ -24,6 +24,14 @@ bool aio::Context::addNameserver(const char *ip) {
     return evdns_base_nameserver_ip_add(mDnsBase, ip) == 0;
 }
 
+std::shared_ptr<aio::net::dns::Cache> aio::Context::dnsCache() {
+    return mDnsCache;
+}
+
+void aio::Context::setDnsCache(std::shared_ptr<net::dns::Cache> cache) {
+    mDnsCache = std::move(cache);
+}
+
 void aio::Context::dispatch() {
     event_base_dispatch(mBase);
 }
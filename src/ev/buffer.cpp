@@ -218,6 +218,92 @@ std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> aio::ev::
     });
 }
 
+nonstd::expected<size_t, aio::Error> aio::ev::Buffer::tryRead(nonstd::span<std::byte> buffer) {
+    nonstd::expected<evbuffer *, Error> input = readable();
+
+    if (!input)
+        return nonstd::make_unexpected(input.error());
+
+    if (evbuffer_get_length(*input) == 0)
+        return nonstd::make_unexpected(mClosed ? IO_EOF : IO_WOULD_BLOCK);
+
+    int n = evbuffer_remove(*input, buffer.data(), buffer.size());
+
+    if (n < 0)
+        return nonstd::make_unexpected(IO_ERROR);
+
+    return n;
+}
+
+nonstd::expected<std::vector<std::byte>, aio::Error> aio::ev::Buffer::tryRead(size_t n) {
+    nonstd::expected<evbuffer *, Error> input = readable();
+
+    if (!input)
+        return nonstd::make_unexpected(input.error());
+
+    size_t length = evbuffer_get_length(*input);
+
+    if (length == 0)
+        return nonstd::make_unexpected(mClosed ? IO_EOF : IO_WOULD_BLOCK);
+
+    std::vector<std::byte> buffer((std::min)(length, n));
+    evbuffer_remove(*input, buffer.data(), buffer.size());
+
+    return buffer;
+}
+
+nonstd::expected<std::string, aio::Error> aio::ev::Buffer::tryReadLine() {
+    return tryReadLine(CRLF);
+}
+
+nonstd::expected<std::string, aio::Error> aio::ev::Buffer::tryReadLine(EOL eol) {
+    nonstd::expected<evbuffer *, Error> input = readable();
+
+    if (!input)
+        return nonstd::make_unexpected(input.error());
+
+    size_t length;
+    char *ptr = evbuffer_readln(*input, &length, (evbuffer_eol_style) eol);
+
+    if (!ptr)
+        return nonstd::make_unexpected(mClosed ? IO_EOF : IO_WOULD_BLOCK);
+
+    std::string line(ptr, length);
+    free(ptr);
+
+    return line;
+}
+
+nonstd::expected<std::vector<std::byte>, aio::Error> aio::ev::Buffer::tryPeek(size_t n) {
+    nonstd::expected<evbuffer *, Error> input = readable();
+
+    if (!input)
+        return nonstd::make_unexpected(input.error());
+
+    if (evbuffer_get_length(*input) < n)
+        return nonstd::make_unexpected(mClosed ? IO_EOF : IO_WOULD_BLOCK);
+
+    std::vector<std::byte> buffer(n);
+    evbuffer_copyout(*input, buffer.data(), n);
+
+    return buffer;
+}
+
+nonstd::expected<std::vector<std::byte>, aio::Error> aio::ev::Buffer::tryReadExactly(size_t n) {
+    nonstd::expected<evbuffer *, Error> input = readable();
+
+    if (!input)
+        return nonstd::make_unexpected(input.error());
+
+    if (evbuffer_get_length(*input) < n)
+        return nonstd::make_unexpected(mClosed ? IO_EOF : IO_WOULD_BLOCK);
+
+    std::vector<std::byte> buffer(n);
+    evbuffer_remove(*input, buffer.data(), n);
+
+    return buffer;
+}
+
 nonstd::expected<void, aio::Error> aio::ev::Buffer::writeLine(std::string_view line) {
     return writeLine(line, CRLF);
 }
@@ -376,6 +462,16 @@ nonstd::expected<void, aio::Error> aio::ev::Buffer::close() {
     return {};
 }
 
+nonstd::expected<evbuffer *, aio::Error> aio::ev::Buffer::readable() {
+    if (!mBev)
+        return nonstd::make_unexpected(IO_BAD_RESOURCE);
+
+    if (mPromises[WAIT_CLOSED_INDEX] || mPromises[READ_INDEX])
+        return nonstd::make_unexpected(IO_BUSY);
+
+    return bufferevent_get_input(mBev);
+}
+
 void aio::ev::Buffer::onClose(const zero::async::promise::Reason &reason) {
     mClosed = true;
 
@@ -10,6 +10,8 @@ aio::ev::Event::Event(const std::shared_ptr<Context> &context, evutil_socket_t f
                 zero::ptr::RefPtr<Event> event((Event *) arg);
 
                 auto p = std::move(event->mPromise);
+
+                event->release();
                 p->resolve(what);
             },
             this
@@ -31,6 +33,8 @@ bool aio::ev::Event::cancel() {
     event_del(mEvent);
 
     auto p = std::move(mPromise);
+
+    release();
     p->reject({IO_CANCELED, "event waiting request was canceled"});
 
     return true;
@@ -69,8 +73,6 @@ aio::ev::Event::on(short events, std::optional<std::chrono::milliseconds> timeou
         };
 
         event_add(mEvent, &tv);
-    })->finally([=]() {
-        release();
     });
 }
 
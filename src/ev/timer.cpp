@@ -8,6 +8,8 @@ aio::ev::Timer::Timer(const std::shared_ptr<Context> &context) {
                 zero::ptr::RefPtr<Timer> timer((Timer *) arg);
 
                 auto p = std::move(timer->mPromise);
+
+                timer->release();
                 p->resolve();
             },
             this
@@ -25,6 +27,8 @@ bool aio::ev::Timer::cancel() {
     evtimer_del(mEvent);
 
     auto p = std::move(mPromise);
+
+    release();
     p->reject({IO_CANCELED, "timer was canceled"});
 
     return true;
@@ -48,8 +52,6 @@ std::shared_ptr<zero::async::promise::Promise<void>> aio::ev::Timer::setTimeout(
         };
 
         evtimer_add(mEvent, &tv);
-    })->finally([=]() {
-        release();
     });
 }
 
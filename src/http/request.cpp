@@ -3,13 +3,61 @@
 #include <aio/ev/event.h>
 #include <fstream>
 
-aio::http::Response::Response(CURL *easy, zero::ptr::RefPtr<ev::IBufferReader> buffer)
-        : mEasy(easy), mBuffer(std::move(buffer)) {
+aio::http::HandlePool::HandlePool(size_t maxSize) : mMaxSize(maxSize) {
 
 }
 
+aio::http::HandlePool::~HandlePool() {
+    for (const auto &easy: mHandles)
+        curl_easy_cleanup(easy);
+}
+
+CURL *aio::http::HandlePool::acquire() {
+    if (mHandles.empty())
+        return curl_easy_init();
+
+    CURL *easy = mHandles.front();
+    mHandles.pop_front();
+
+    return easy;
+}
+
+void aio::http::HandlePool::recycle(CURL *easy) {
+    if (mHandles.size() >= mMaxSize) {
+        curl_easy_cleanup(easy);
+        return;
+    }
+
+    curl_easy_setopt(easy, CURLOPT_COOKIELIST, "ALL");
+    curl_easy_reset(easy);
+
+    mHandles.push_front(easy);
+}
+
+size_t aio::http::HandlePool::idle() {
+    return mHandles.size();
+}
+
+aio::http::Response::Response(
+        CURL *easy,
+        zero::ptr::RefPtr<ev::IBufferReader> buffer,
+        std::weak_ptr<HandlePool> pool,
+        bool buffered
+) : mEasy(easy), mBuffered(buffered), mBuffer(std::move(buffer)), mPool(std::move(pool)) {
+    zero::async::promise::chain<void>([=](const auto &p) {
+        mDone = p;
+    });
+}
+
 aio::http::Response::~Response() {
-    curl_easy_cleanup(mEasy);
+    std::shared_ptr<HandlePool> pool = mPool.lock();
+
+    if (!pool) {
+        curl_easy_cleanup(mEasy);
+        return;
+    }
+
+    pool->recycle(mEasy);
 }
 
 long aio::http::Response::statusCode() {
@@ -56,6 +104,48 @@ std::map<std::string, std::string> &aio::http::Response::headers() {
     return mHeaders;
 }
 
+void aio::http::Response::resume() {
+    curl_easy_pause(mEasy, CURLPAUSE_CONT);
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>> aio::http::Response::done() {
+    return mDone;
+}
+
+std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> aio::http::Response::body() {
+    if (!mBuffered)
+        return zero::async::promise::reject<std::vector<std::byte>>(
+                {INVALID_ARGUMENT, "http response body is not buffered"}
+        );
+
+    addRef();
+
+    return mDone->then([=]() {
+        return std::move(mBody);
+    })->finally([=]() {
+        release();
+    });
+}
+
+nonstd::expected<void, aio::Error> aio::http::Response::append(nonstd::span<const std::byte> data) {
+    try {
+        if (mBody.empty()) {
+            std::optional<curl_off_t> length = contentLength();
+
+            if (length && *length > 0 && (size_t) *length > data.size())
+                mBody.reserve((std::min)((size_t) *length, (size_t) MAX_BODY_RESERVE));
+        }
+
+        mBody.insert(mBody.end(), data.begin(), data.end());
+    } catch (const std::bad_alloc &) {
+        return nonstd::make_unexpected(IO_ERROR);
+    } catch (const std::length_error &) {
+        return nonstd::make_unexpected(IO_ERROR);
+    }
+
+    return {};
+}
+
 std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> aio::http::Response::read(size_t n) {
     return mBuffer->read(n);
 }
@@ -80,6 +170,30 @@ std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> aio::http
     return mBuffer->readExactly(n);
 }
 
+nonstd::expected<size_t, aio::Error> aio::http::Response::tryRead(nonstd::span<std::byte> buffer) {
+    return mBuffer->tryRead(buffer);
+}
+
+nonstd::expected<std::vector<std::byte>, aio::Error> aio::http::Response::tryRead(size_t n) {
+    return mBuffer->tryRead(n);
+}
+
+nonstd::expected<std::string, aio::Error> aio::http::Response::tryReadLine() {
+    return mBuffer->tryReadLine();
+}
+
+nonstd::expected<std::string, aio::Error> aio::http::Response::tryReadLine(ev::EOL eol) {
+    return mBuffer->tryReadLine(eol);
+}
+
+nonstd::expected<std::vector<std::byte>, aio::Error> aio::http::Response::tryPeek(size_t n) {
+    return mBuffer->tryPeek(n);
+}
+
+nonstd::expected<std::vector<std::byte>, aio::Error> aio::http::Response::tryReadExactly(size_t n) {
+    return mBuffer->tryReadExactly(n);
+}
+
 std::shared_ptr<zero::async::promise::Promise<void>> aio::http::Response::output(const std::filesystem::path &path) {
     std::shared_ptr<std::ofstream> stream = std::make_shared<std::ofstream>(path, std::ios::binary);
 
@@ -118,6 +232,11 @@ std::shared_ptr<zero::async::promise::Promise<void>> aio::http::Response::output
 }
 
 std::shared_ptr<zero::async::promise::Promise<std::string>> aio::http::Response::string() {
+    if (mBuffered)
+        return body()->then([](nonstd::span<const std::byte> data) {
+            return std::string{(const char *) data.data(), data.size()};
+        });
+
     std::optional<curl_off_t> length = contentLength();
 
     if (length)
@@ -151,14 +270,92 @@ std::shared_ptr<zero::async::promise::Promise<nlohmann::json>> aio::http::Respon
     );
 }
 
+aio::http::Share::Share(CURLSH *share) : mShare(share) {
+    curl_share_setopt(mShare, CURLSHOPT_USERDATA, this);
+
+    curl_share_setopt(
+            mShare,
+            CURLSHOPT_LOCKFUNC,
+            static_cast<void (*)(CURL *, curl_lock_data, curl_lock_access, void *)>(
+                    [](CURL *, curl_lock_data data, curl_lock_access, void *userdata) {
+                        static_cast<Share *>(userdata)->mMutexes[data].lock();
+                    }
+            )
+    );
+
+    curl_share_setopt(
+            mShare,
+            CURLSHOPT_UNLOCKFUNC,
+            static_cast<void (*)(CURL *, curl_lock_data, void *)>(
+                    [](CURL *, curl_lock_data data, void *userdata) {
+                        static_cast<Share *>(userdata)->mMutexes[data].unlock();
+                    }
+            )
+    );
+
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+aio::http::Share::~Share() {
+    curl_share_cleanup(mShare);
+}
+
+CURLSH *aio::http::Share::handle() {
+    return mShare;
+}
+
+std::shared_ptr<aio::http::Share> aio::http::newShare(bool connections) {
+    CURLSH *share = curl_share_init();
+
+    if (!share)
+        return nullptr;
+
+    std::shared_ptr<Share> result = std::make_shared<Share>(share);
+
+#if CURL_AT_LEAST_VERSION(7, 57, 0)
+    if (connections && curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT) != CURLSHE_OK)
+        return nullptr;
+#else
+    if (connections)
+        return nullptr;
+#endif
+
+    return result;
+}
+
 aio::http::Requests::Requests(const std::shared_ptr<Context> &context) : Requests(context, Options{}) {
 
 }
 
 aio::http::Requests::Requests(const std::shared_ptr<Context> &context, Options options)
-        : mContext(context), mOptions(std::move(options)), mTimer(zero::ptr::makeRef<ev::Timer>(context)) {
+        : Requests(context, std::move(options), Config{}) {
+
+}
+
+aio::http::Requests::Requests(const std::shared_ptr<Context> &context, Options options, const Config &config)
+        : mContext(context), mOptions(std::move(options)), mConfig(config), mStatistics(),
+          mHandles(std::make_shared<HandlePool>(config.maxIdleHandles.value_or(MAX_IDLE_HANDLES))),
+          mTimer(zero::ptr::makeRef<ev::Timer>(context)) {
     mMulti = curl_multi_init();
 
+    if (mConfig.multiplex)
+        curl_multi_setopt(mMulti, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    if (mConfig.maxHostConnections)
+        curl_multi_setopt(mMulti, CURLMOPT_MAX_HOST_CONNECTIONS, *mConfig.maxHostConnections);
+
+    if (mConfig.maxTotalConnections)
+        curl_multi_setopt(mMulti, CURLMOPT_MAX_TOTAL_CONNECTIONS, *mConfig.maxTotalConnections);
+
+    if (mConfig.maxConnects)
+        curl_multi_setopt(mMulti, CURLMOPT_MAXCONNECTS, *mConfig.maxConnects);
+
+#if CURL_AT_LEAST_VERSION(7, 67, 0)
+    if (mConfig.maxConcurrentStreams)
+        curl_multi_setopt(mMulti, CURLMOPT_MAX_CONCURRENT_STREAMS, *mConfig.maxConcurrentStreams);
+#endif
+
     curl_multi_setopt(
             mMulti,
             CURLMOPT_SOCKETFUNCTION,
@@ -272,9 +469,20 @@ void aio::http::Requests::recycle() {
         Connection *connection;
         curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &connection);
 
+        long connects = 0;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_NUM_CONNECTS, &connects);
+
+        mStatistics.requests++;
+        mStatistics.connects += connects;
+
+        if (msg->data.result == CURLE_OK && connects == 0)
+            mStatistics.reused++;
+
         if (msg->data.result != CURLE_OK) {
             std::string message = zero::strings::format("http request error[%s]", connection->error);
 
+            connection->response->mDone->reject({HTTP_REQUEST_ERROR, message});
+
             if (!connection->transferring) {
                 connection->promise->reject({HTTP_REQUEST_ERROR, std::move(message)});
             } else {
@@ -282,9 +490,15 @@ void aio::http::Requests::recycle() {
             }
         } else {
             connection->buffer->close();
+            connection->response->mDone->resolve();
         }
 
-        curl_multi_remove_handle(mMulti, msg->easy_handle);
+        CURL *easy = msg->easy_handle;
+        curl_multi_remove_handle(mMulti, easy);
+
+        if (mConfig.share)
+            curl_easy_setopt(easy, CURLOPT_SHARE, nullptr);
+
         delete connection;
     }
 }
@@ -292,3 +506,10 @@ void aio::http::Requests::recycle() {
 aio::http::Options &aio::http::Requests::options() {
     return mOptions;
 }
+
+aio::http::Statistics aio::http::Requests::statistics() {
+    Statistics statistics = mStatistics;
+    statistics.idleHandles = mHandles->idle();
+
+    return statistics;
+}
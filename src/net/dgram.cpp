@@ -5,13 +5,26 @@
 
 #ifdef __linux__
 #include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+constexpr size_t MAX_GSO_SEGMENTS = 64;
+constexpr size_t MAX_GSO_SIZE = 65507;
 #endif
 
 constexpr auto READ_INDEX = 0;
 constexpr auto WRITE_INDEX = 1;
 
 aio::net::dgram::Socket::Socket(evutil_socket_t fd, zero::ptr::RefPtr<ev::Event> events[2])
-        : mFD(fd), mClosed(false), mEvents{std::move(events[0]), std::move(events[1])} {
+        : mFD(fd), mClosed(false), mEvents{std::move(events[0]), std::move(events[1])}, mSlabSize(0) {
 
 }
 
@@ -88,7 +101,607 @@ aio::net::dgram::Socket::readFrom(size_t n) {
                 return;
             }
 
-            P_BREAK_V(loop, std::pair{std::vector<std::byte>{buffer.get(), buffer.get() + num}, *address});
+            P_BREAK_V(loop, std::pair{std::vector<std::byte>{buffer.get(), buffer.get() + num}, *address});
+            return;
+        }
+
+        mEvents[READ_INDEX]->on(ev::READ, mTimeouts[READ_INDEX])->then([=](short what) {
+            if (what & ev::TIMEOUT) {
+                P_BREAK_E(loop, { IO_TIMEOUT, "datagram socket read timed out" });
+                return;
+            }
+
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            if (reason.code == IO_CANCELED) {
+                P_BREAK_E(loop, { IO_EOF, "datagram socket is being closed" });
+                return;
+            }
+
+            P_BREAK_E(loop, reason);
+        });
+    })->finally([=]() {
+        release();
+    });
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>>
+aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Address &address) {
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
+
+    if (!socketAddress)
+        return zero::async::promise::reject<void>({INVALID_ARGUMENT, "invalid socket address"});
+
+    return writeTo(buffer, *socketAddress);
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>>
+aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const SocketAddress &address) {
+    nonstd::expected<void, Error> result = trySendTo(buffer, address);
+
+    if (result)
+        return zero::async::promise::resolve<void>();
+
+    switch (result.error()) {
+        case IO_WOULD_BLOCK:
+            break;
+
+        case IO_EOF:
+            return zero::async::promise::reject<void>({IO_EOF, "write closed datagram socket"});
+
+        case IO_BUSY:
+            return zero::async::promise::reject<void>(
+                    {IO_BUSY, "datagram socket pending write request not completed"}
+            );
+
+        default:
+            return zero::async::promise::reject<void>(
+                    {
+                            result.error(),
+                            zero::strings::format(
+                                    "datagram socket send data to remote failed[%s]",
+                                    lastError().c_str()
+                            )
+                    }
+            );
+    }
+
+    addRef();
+
+    return zero::async::promise::loop<void>(
+            [=, data = std::vector<std::byte>{buffer.begin(), buffer.end()}](const auto &loop) {
+                if (mClosed) {
+                    P_BREAK_E(loop, { IO_EOF, "write closed datagram socket" });
+                    return;
+                }
+
+                if (mEvents[WRITE_INDEX]->pending()) {
+                    P_BREAK_E(loop, { IO_BUSY, "datagram socket pending write request not completed" });
+                    return;
+                }
+
+#ifdef _WIN32
+                int num = sendto(
+                        mFD,
+                        (const char *) data.data(),
+                        (int) data.size(),
+                        0,
+                        (const sockaddr *) &address.storage,
+                        address.length
+                );
+
+                if (num == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK) {
+                    P_BREAK_E(
+                            loop,
+                            {
+                                IO_ERROR,
+                                zero::strings::format(
+                                        "datagram socket send data to remote failed[%s]",
+                                        lastError().c_str()
+                                )
+                            }
+                    );
+
+                    return;
+                }
+#else
+                ssize_t num = sendto(
+                        mFD,
+                        data.data(),
+                        data.size(),
+                        0,
+                        (const sockaddr *) &address.storage,
+                        address.length
+                );
+
+                if (num == -1 && errno != EWOULDBLOCK) {
+                    P_BREAK_E(
+                            loop,
+                            {
+                                IO_ERROR,
+                                zero::strings::format(
+                                        "datagram socket send data to remote failed[%s]",
+                                        lastError().c_str()
+                                )
+                            }
+                    );
+
+                    return;
+                }
+#endif
+
+                if (num == 0) {
+                    P_BREAK_E(loop, { IO_EOF, "datagram socket is closed" });
+                    return;
+                }
+
+                if (num > 0) {
+                    P_BREAK(loop);
+                    return;
+                }
+
+                mEvents[WRITE_INDEX]->on(ev::WRITE, mTimeouts[WRITE_INDEX])->then([=](short what) {
+                    if (what & ev::TIMEOUT) {
+                        P_BREAK_E(loop, { IO_TIMEOUT, "datagram socket write timed out" });
+                        return;
+                    }
+
+                    P_CONTINUE(loop);
+                }, [=](const zero::async::promise::Reason &reason) {
+                    if (reason.code == IO_CANCELED) {
+                        P_BREAK_E(loop, { IO_EOF, "datagram socket is being closed" });
+                        return;
+                    }
+
+                    P_BREAK_E(loop, reason);
+                });
+            }
+    )->finally([=]() {
+        release();
+    });
+}
+
+nonstd::expected<void, aio::Error>
+aio::net::dgram::Socket::trySendTo(nonstd::span<const std::byte> buffer, const Address &address) {
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
+
+    if (!socketAddress)
+        return nonstd::make_unexpected(INVALID_ARGUMENT);
+
+    return trySendTo(buffer, *socketAddress);
+}
+
+nonstd::expected<void, aio::Error>
+aio::net::dgram::Socket::trySendTo(nonstd::span<const std::byte> buffer, const SocketAddress &address) {
+    if (mClosed)
+        return nonstd::make_unexpected(IO_EOF);
+
+    if (mEvents[WRITE_INDEX]->pending())
+        return nonstd::make_unexpected(IO_BUSY);
+
+#ifdef _WIN32
+    int num = sendto(
+            mFD,
+            (const char *) buffer.data(),
+            (int) buffer.size(),
+            0,
+            (const sockaddr *) &address.storage,
+            address.length
+    );
+
+    if (num == SOCKET_ERROR)
+        return nonstd::make_unexpected(WSAGetLastError() == WSAEWOULDBLOCK ? IO_WOULD_BLOCK : IO_ERROR);
+#else
+    ssize_t num = sendto(mFD, buffer.data(), buffer.size(), 0, (const sockaddr *) &address.storage, address.length);
+
+    if (num == -1)
+        return nonstd::make_unexpected(errno == EWOULDBLOCK ? IO_WOULD_BLOCK : IO_ERROR);
+#endif
+
+    return {};
+}
+
+std::shared_ptr<zero::async::promise::Promise<aio::net::dgram::DatagramBatch>>
+aio::net::dgram::Socket::readBatch(size_t maxMessages, size_t maxSize) {
+    if (maxMessages == 0 || maxSize == 0)
+        return zero::async::promise::reject<DatagramBatch>({INVALID_ARGUMENT, "invalid datagram batch size"});
+
+    addRef();
+
+    return zero::async::promise::loop<DatagramBatch>([=](const auto &loop) {
+        if (mClosed) {
+            P_BREAK_E(loop, { IO_EOF, "read closed datagram socket" });
+            return;
+        }
+
+        if (mEvents[READ_INDEX]->pending()) {
+            P_BREAK_E(loop, { IO_BUSY, "datagram socket pending read request not completed" });
+            return;
+        }
+
+        std::shared_ptr<std::byte[]> buffer = slab(maxMessages * maxSize);
+        std::vector<sockaddr_storage> storages(maxMessages);
+        std::vector<size_t> lengths;
+        std::vector<socklen_t> addressLengths;
+
+#ifdef __linux__
+        std::vector<iovec> vectors(maxMessages);
+        std::vector<mmsghdr> messages(maxMessages);
+
+        for (size_t i = 0; i < maxMessages; i++) {
+            vectors[i] = {buffer.get() + i * maxSize, maxSize};
+
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = &storages[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int num = recvmmsg(mFD, messages.data(), maxMessages, 0, nullptr);
+
+        if (num == -1 && errno != EWOULDBLOCK) {
+            P_BREAK_E(
+                    loop,
+                    { IO_ERROR, zero::strings::format("receive from datagram socket failed [%s]", lastError().c_str()) }
+            );
+
+            return;
+        }
+
+        for (int i = 0; i < num; i++) {
+            lengths.push_back(messages[i].msg_len);
+            addressLengths.push_back(messages[i].msg_hdr.msg_namelen);
+        }
+#else
+        while (lengths.size() < maxMessages) {
+            socklen_t length = sizeof(sockaddr_storage);
+            std::byte *data = buffer.get() + lengths.size() * maxSize;
+            auto storage = (sockaddr *) &storages[lengths.size()];
+
+#ifdef _WIN32
+            int num = recvfrom(mFD, (char *) data, (int) maxSize, 0, storage, &length);
+
+            if (num == SOCKET_ERROR) {
+                if (WSAGetLastError() == WSAEWOULDBLOCK || !lengths.empty())
+                    break;
+#else
+            ssize_t num = recvfrom(mFD, data, maxSize, 0, storage, &length);
+
+            if (num == -1) {
+                if (errno == EWOULDBLOCK || !lengths.empty())
+                    break;
+#endif
+                P_BREAK_E(
+                        loop,
+                        {
+                            IO_ERROR,
+                            zero::strings::format("receive from datagram socket failed [%s]", lastError().c_str())
+                        }
+                );
+
+                return;
+            }
+
+            lengths.push_back(num);
+            addressLengths.push_back(length);
+        }
+#endif
+
+        if (!lengths.empty()) {
+            DatagramBatch batch = {buffer};
+
+            for (size_t i = 0; i < lengths.size(); i++) {
+                auto storage = (const sockaddr *) &storages[i];
+
+                std::optional<Address> address = addressFrom(storage);
+                std::optional<SocketAddress> socketAddress = socketAddressFrom(storage, addressLengths[i]);
+
+                if (!address || !socketAddress) {
+                    P_BREAK_E(loop, { INVALID_ARGUMENT, "failed to parse socket address" });
+                    return;
+                }
+
+                batch.datagrams.push_back(
+                        {{buffer.get() + i * maxSize, lengths[i]}, std::move(*address), *socketAddress}
+                );
+            }
+
+            P_BREAK_V(loop, std::move(batch));
+            return;
+        }
+
+        mEvents[READ_INDEX]->on(ev::READ, mTimeouts[READ_INDEX])->then([=](short what) {
+            if (what & ev::TIMEOUT) {
+                P_BREAK_E(loop, { IO_TIMEOUT, "datagram socket read timed out" });
+                return;
+            }
+
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            if (reason.code == IO_CANCELED) {
+                P_BREAK_E(loop, { IO_EOF, "datagram socket is being closed" });
+                return;
+            }
+
+            P_BREAK_E(loop, reason);
+        });
+    })->finally([=]() {
+        release();
+    });
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>>
+aio::net::dgram::Socket::writeBatch(nonstd::span<const Datagram> datagrams) {
+    struct Batch {
+        size_t sent;
+        std::vector<std::byte> payload;
+        std::vector<size_t> offsets;
+        std::vector<SocketAddress> addresses;
+    };
+
+    if (datagrams.empty())
+        return zero::async::promise::resolve<void>();
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+
+    batch->sent = 0;
+    batch->offsets.push_back(0);
+
+    for (const auto &datagram: datagrams) {
+        std::optional<SocketAddress> socketAddress = socketAddressFrom(datagram.address);
+
+        if (!socketAddress)
+            return zero::async::promise::reject<void>({INVALID_ARGUMENT, "invalid socket address"});
+
+        batch->payload.insert(batch->payload.end(), datagram.data.begin(), datagram.data.end());
+        batch->offsets.push_back(batch->payload.size());
+        batch->addresses.push_back(*socketAddress);
+    }
+
+    addRef();
+
+    return zero::async::promise::loop<void>([=](const auto &loop) {
+        if (mClosed) {
+            P_BREAK_E(loop, { IO_EOF, "write closed datagram socket" });
+            return;
+        }
+
+        if (mEvents[WRITE_INDEX]->pending()) {
+            P_BREAK_E(loop, { IO_BUSY, "datagram socket pending write request not completed" });
+            return;
+        }
+
+        size_t total = batch->addresses.size();
+
+#ifdef __linux__
+        size_t count = total - batch->sent;
+
+        std::vector<iovec> vectors(count);
+        std::vector<mmsghdr> messages(count);
+
+        for (size_t i = 0; i < count; i++) {
+            size_t index = batch->sent + i;
+
+            vectors[i] = {
+                    batch->payload.data() + batch->offsets[index],
+                    batch->offsets[index + 1] - batch->offsets[index]
+            };
+
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = &batch->addresses[index].storage;
+            messages[i].msg_hdr.msg_namelen = batch->addresses[index].length;
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int num = sendmmsg(mFD, messages.data(), count, 0);
+
+        if (num == -1 && errno != EWOULDBLOCK) {
+            P_BREAK_E(
+                    loop,
+                    {
+                        IO_ERROR,
+                        zero::strings::format("datagram socket send data to remote failed[%s]", lastError().c_str())
+                    }
+            );
+
+            return;
+        }
+
+        if (num > 0)
+            batch->sent += num;
+#else
+        while (batch->sent < total) {
+            size_t index = batch->sent;
+            const SocketAddress &address = batch->addresses[index];
+
+#ifdef _WIN32
+            int num = sendto(
+                    mFD,
+                    (const char *) batch->payload.data() + batch->offsets[index],
+                    (int) (batch->offsets[index + 1] - batch->offsets[index]),
+                    0,
+                    (const sockaddr *) &address.storage,
+                    address.length
+            );
+
+            if (num == SOCKET_ERROR) {
+                if (WSAGetLastError() == WSAEWOULDBLOCK)
+                    break;
+#else
+            ssize_t num = sendto(
+                    mFD,
+                    batch->payload.data() + batch->offsets[index],
+                    batch->offsets[index + 1] - batch->offsets[index],
+                    0,
+                    (const sockaddr *) &address.storage,
+                    address.length
+            );
+
+            if (num == -1) {
+                if (errno == EWOULDBLOCK)
+                    break;
+#endif
+                P_BREAK_E(
+                        loop,
+                        {
+                            IO_ERROR,
+                            zero::strings::format(
+                                    "datagram socket send data to remote failed[%s]",
+                                    lastError().c_str()
+                            )
+                        }
+                );
+
+                return;
+            }
+
+            batch->sent++;
+        }
+#endif
+
+        if (batch->sent == total) {
+            P_BREAK(loop);
+            return;
+        }
+
+        mEvents[WRITE_INDEX]->on(ev::WRITE, mTimeouts[WRITE_INDEX])->then([=](short what) {
+            if (what & ev::TIMEOUT) {
+                P_BREAK_E(loop, { IO_TIMEOUT, "datagram socket write timed out" });
+                return;
+            }
+
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            if (reason.code == IO_CANCELED) {
+                P_BREAK_E(loop, { IO_EOF, "datagram socket is being closed" });
+                return;
+            }
+
+            P_BREAK_E(loop, reason);
+        });
+    })->finally([=]() {
+        release();
+    });
+}
+
+nonstd::expected<void, aio::Error> aio::net::dgram::Socket::setOptions(const SocketOptions &options) {
+    if (mClosed)
+        return nonstd::make_unexpected(IO_BAD_RESOURCE);
+
+    return setSocketOptions(mFD, options);
+}
+
+nonstd::expected<void, aio::Error> aio::net::dgram::Socket::setGRO(bool enable) {
+#ifdef __linux__
+    int value = enable ? 1 : 0;
+
+    if (setsockopt(mFD, SOL_UDP, UDP_GRO, &value, sizeof(value)) != 0)
+        return nonstd::make_unexpected(IO_ERROR);
+
+    return {};
+#else
+    return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+}
+
+std::shared_ptr<zero::async::promise::Promise<aio::net::dgram::SegmentedDatagram>>
+aio::net::dgram::Socket::readSegments(size_t n) {
+    addRef();
+
+    return zero::async::promise::loop<SegmentedDatagram>([=](const auto &loop) {
+        if (mClosed) {
+            P_BREAK_E(loop, { IO_EOF, "read closed datagram socket" });
+            return;
+        }
+
+        if (mEvents[READ_INDEX]->pending()) {
+            P_BREAK_E(loop, { IO_BUSY, "datagram socket pending read request not completed" });
+            return;
+        }
+
+        sockaddr_storage storage = {};
+        std::vector<std::byte> buffer(n);
+        std::optional<size_t> segmentSize;
+
+#ifdef __linux__
+        char control[CMSG_SPACE(sizeof(int))] = {};
+        iovec vec = {buffer.data(), n};
+
+        msghdr message = {};
+
+        message.msg_name = &storage;
+        message.msg_namelen = sizeof(sockaddr_storage);
+        message.msg_iov = &vec;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t num = recvmsg(mFD, &message, 0);
+
+        if (num == -1 && errno != EWOULDBLOCK) {
+            P_BREAK_E(
+                    loop,
+                    { IO_ERROR, zero::strings::format("receive from datagram socket failed [%s]", lastError().c_str()) }
+            );
+
+            return;
+        }
+
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            if (cmsg->cmsg_level != SOL_UDP || cmsg->cmsg_type != UDP_GRO)
+                continue;
+
+            segmentSize = *(int *) CMSG_DATA(cmsg);
+            break;
+        }
+
+        if (num > 0 && (message.msg_flags & MSG_TRUNC)) {
+            P_BREAK_E(loop, { IO_ERROR, "datagram was truncated, receive buffer is too small" });
+            return;
+        }
+#else
+        socklen_t length = sizeof(sockaddr_storage);
+
+#ifdef _WIN32
+        int num = recvfrom(mFD, (char *) buffer.data(), (int) n, 0, (sockaddr *) &storage, &length);
+
+        if (num == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK) {
+#else
+        ssize_t num = recvfrom(mFD, buffer.data(), n, 0, (sockaddr *) &storage, &length);
+
+        if (num == -1 && errno != EWOULDBLOCK) {
+#endif
+            P_BREAK_E(
+                    loop,
+                    { IO_ERROR, zero::strings::format("receive from datagram socket failed [%s]", lastError().c_str()) }
+            );
+
+            return;
+        }
+#endif
+
+        if (num == 0) {
+            P_BREAK_E(loop, { IO_EOF, "datagram socket is closed" });
+            return;
+        }
+
+        if (num > 0) {
+            std::optional<Address> address = addressFrom((const sockaddr *) &storage);
+
+            if (!address) {
+                P_BREAK_E(loop, { INVALID_ARGUMENT, "failed to parse socket address" });
+                return;
+            }
+
+            buffer.resize(num);
+
+            P_BREAK_V(
+                    loop,
+                    SegmentedDatagram{std::move(buffer), segmentSize.value_or((size_t) num), std::move(*address)}
+            );
+
             return;
         }
 
@@ -112,9 +725,19 @@ aio::net::dgram::Socket::readFrom(size_t n) {
     });
 }
 
-std::shared_ptr<zero::async::promise::Promise<void>>
-aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Address &address) {
-    std::optional<std::vector<std::byte>> socketAddress = socketAddressFrom(address);
+std::shared_ptr<zero::async::promise::Promise<void>> aio::net::dgram::Socket::writeSegments(
+        nonstd::span<const std::byte> buffer,
+        size_t segmentSize,
+        const Address &address
+) {
+    if (segmentSize == 0)
+        return zero::async::promise::reject<void>({INVALID_ARGUMENT, "invalid segment size"});
+
+    if (buffer.empty())
+        return zero::async::promise::resolve<void>();
+
+#ifdef __linux__
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
 
     if (!socketAddress)
         return zero::async::promise::reject<void>({INVALID_ARGUMENT, "invalid socket address"});
@@ -124,8 +747,9 @@ aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Add
     return zero::async::promise::loop<void>(
             [
                     =,
-                    socketAddress = std::move(*socketAddress),
-                    data = std::vector<std::byte>{buffer.begin(), buffer.end()}
+                    socketAddress = *socketAddress,
+                    data = std::vector<std::byte>{buffer.begin(), buffer.end()},
+                    offset = std::make_shared<size_t>()
             ](const auto &loop) {
                 if (mClosed) {
                     P_BREAK_E(loop, { IO_EOF, "write closed datagram socket" });
@@ -137,39 +761,33 @@ aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Add
                     return;
                 }
 
-#ifdef _WIN32
-                int num = sendto(
-                        mFD,
-                        (const char *) data.data(),
-                        (int) data.size(),
-                        0,
-                        (const sockaddr *) socketAddress.data(),
-                        sizeof(sockaddr_storage)
-                );
+                size_t segments = (std::max)((size_t) 1, (std::min)(MAX_GSO_SEGMENTS, MAX_GSO_SIZE / segmentSize));
+                size_t length = (std::min)(data.size() - *offset, segments * segmentSize);
 
-                if (num == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK) {
-                    P_BREAK_E(
-                            loop,
-                            {
-                                IO_ERROR,
-                                zero::strings::format(
-                                        "datagram socket send data to remote failed[%s]",
-                                        lastError().c_str()
-                                )
-                            }
-                    );
+                char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+                iovec vec = {(void *) (data.data() + *offset), length};
 
-                    return;
+                msghdr message = {};
+
+                message.msg_name = (void *) &socketAddress.storage;
+                message.msg_namelen = socketAddress.length;
+                message.msg_iov = &vec;
+                message.msg_iovlen = 1;
+
+                if (length > segmentSize) {
+                    message.msg_control = control;
+                    message.msg_controllen = sizeof(control);
+
+                    cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+
+                    cmsg->cmsg_level = SOL_UDP;
+                    cmsg->cmsg_type = UDP_SEGMENT;
+                    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+
+                    *(uint16_t *) CMSG_DATA(cmsg) = (uint16_t) segmentSize;
                 }
-#else
-                ssize_t num = sendto(
-                        mFD,
-                        data.data(),
-                        data.size(),
-                        0,
-                        (const sockaddr *) socketAddress.data(),
-                        sizeof(sockaddr_storage)
-                );
+
+                ssize_t num = sendmsg(mFD, &message, 0);
 
                 if (num == -1 && errno != EWOULDBLOCK) {
                     P_BREAK_E(
@@ -177,7 +795,7 @@ aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Add
                             {
                                 IO_ERROR,
                                 zero::strings::format(
-                                        "datagram socket send data to remote failed[%s]",
+                                        "datagram socket send segments to remote failed[%s]",
                                         lastError().c_str()
                                 )
                             }
@@ -185,15 +803,16 @@ aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Add
 
                     return;
                 }
-#endif
 
-                if (num == 0) {
-                    P_BREAK_E(loop, { IO_EOF, "datagram socket is closed" });
-                    return;
-                }
+                if (num >= 0) {
+                    *offset += length;
 
-                if (num > 0) {
-                    P_BREAK(loop);
+                    if (*offset == data.size()) {
+                        P_BREAK(loop);
+                        return;
+                    }
+
+                    P_CONTINUE(loop);
                     return;
                 }
 
@@ -216,6 +835,14 @@ aio::net::dgram::Socket::writeTo(nonstd::span<const std::byte> buffer, const Add
     )->finally([=]() {
         release();
     });
+#else
+    std::vector<Datagram> datagrams;
+
+    for (size_t offset = 0; offset < buffer.size(); offset += segmentSize)
+        datagrams.push_back({buffer.subspan(offset, (std::min)(segmentSize, buffer.size() - offset)), address});
+
+    return writeBatch(datagrams);
+#endif
 }
 
 std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> aio::net::dgram::Socket::read(size_t n) {
@@ -418,22 +1045,22 @@ evutil_socket_t aio::net::dgram::Socket::fd() {
 }
 
 bool aio::net::dgram::Socket::bind(const Address &address) {
-    std::optional<std::vector<std::byte>> socketAddress = socketAddressFrom(address);
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
 
     if (!socketAddress)
         return false;
 
-    return ::bind(mFD, (const sockaddr *) socketAddress->data(), sizeof(sockaddr_storage)) == 0;
+    return ::bind(mFD, (const sockaddr *) &socketAddress->storage, socketAddress->length) == 0;
 }
 
 std::shared_ptr<zero::async::promise::Promise<void>>
 aio::net::dgram::Socket::connect(const Address &address) {
-    std::optional<std::vector<std::byte>> socketAddress = socketAddressFrom(address);
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
 
     if (!socketAddress)
         return zero::async::promise::reject<void>({INVALID_ARGUMENT, "invalid socket address"});
 
-    if (::connect(mFD, (const sockaddr *) socketAddress->data(), sizeof(sockaddr_storage)) != 0)
+    if (::connect(mFD, (const sockaddr *) &socketAddress->storage, socketAddress->length) != 0)
         return zero::async::promise::reject<void>(
                 {
                         IO_ERROR,
@@ -444,6 +1071,355 @@ aio::net::dgram::Socket::connect(const Address &address) {
     return zero::async::promise::resolve<void>();
 }
 
+std::shared_ptr<std::byte[]> aio::net::dgram::Socket::slab(size_t size) {
+    if (!mSlab || mSlab.use_count() > 1 || mSlabSize < size) {
+        mSlab = std::shared_ptr<std::byte[]>(new std::byte[size]);
+        mSlabSize = size;
+    }
+
+    return mSlab;
+}
+
+aio::net::dgram::Session::Session(
+        zero::ptr::RefPtr<Listener> listener,
+        Address address,
+        const SocketAddress &socketAddress
+) : mClosed(false), mAddress(std::move(address)), mSocketAddress(socketAddress), mListener(std::move(listener)),
+    mChannel(zero::ptr::makeRef<Channel<std::vector<std::byte>, 128>>(mListener->mContext)) {
+
+}
+
+aio::net::dgram::Session::~Session() {
+    if (mClosed)
+        return;
+
+    mListener->mSessions.erase(mSocketAddress);
+}
+
+std::shared_ptr<zero::async::promise::Promise<std::vector<std::byte>>> aio::net::dgram::Session::read(size_t n) {
+    std::optional<std::chrono::milliseconds> timeout = mTimeouts[READ_INDEX];
+
+    return zero::async::promise::chain<std::vector<std::byte>>([=](const auto &p) {
+        (timeout ? mChannel->receive(*timeout) : mChannel->receive())->then(
+                [=](const std::vector<std::byte> &datagram) {
+                    if (datagram.size() <= n) {
+                        p->resolve(datagram);
+                        return;
+                    }
+
+                    p->resolve(std::vector<std::byte>{datagram.begin(), datagram.begin() + (long) n});
+                },
+                [=](const zero::async::promise::Reason &reason) {
+                    if (reason.code == IO_EOF && mListener->mError) {
+                        p->reject(*mListener->mError);
+                        return;
+                    }
+
+                    p->reject(reason);
+                }
+        );
+    });
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>>
+aio::net::dgram::Session::write(nonstd::span<const std::byte> buffer) {
+    if (mClosed)
+        return zero::async::promise::reject<void>({IO_EOF, "write closed datagram session"});
+
+    return mListener->send(buffer, mSocketAddress, mTimeouts[WRITE_INDEX]);
+}
+
+nonstd::expected<void, aio::Error> aio::net::dgram::Session::close() {
+    if (mClosed)
+        return nonstd::make_unexpected(IO_EOF);
+
+    mClosed = true;
+    mListener->mSessions.erase(mSocketAddress);
+    mChannel->close();
+
+    return {};
+}
+
+std::optional<aio::net::Address> aio::net::dgram::Session::localAddress() {
+    if (mClosed)
+        return std::nullopt;
+
+    return mListener->localAddress();
+}
+
+std::optional<aio::net::Address> aio::net::dgram::Session::remoteAddress() {
+    if (mClosed)
+        return std::nullopt;
+
+    return mAddress;
+}
+
+void aio::net::dgram::Session::setTimeout(std::chrono::milliseconds timeout) {
+    setTimeout(timeout, timeout);
+}
+
+void aio::net::dgram::Session::setTimeout(
+        std::chrono::milliseconds readTimeout,
+        std::chrono::milliseconds writeTimeout
+) {
+    if (readTimeout != std::chrono::milliseconds::zero())
+        mTimeouts[READ_INDEX] = readTimeout;
+    else
+        mTimeouts[READ_INDEX].reset();
+
+    if (writeTimeout != std::chrono::milliseconds::zero())
+        mTimeouts[WRITE_INDEX] = writeTimeout;
+    else
+        mTimeouts[WRITE_INDEX].reset();
+}
+
+evutil_socket_t aio::net::dgram::Session::fd() {
+    if (mClosed)
+        return -1;
+
+    return mListener->mSocket->fd();
+}
+
+bool aio::net::dgram::Session::bind(const Address &address) {
+    return false;
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>> aio::net::dgram::Session::connect(const Address &address) {
+    return zero::async::promise::reject<void>({INVALID_ARGUMENT, "datagram session is already connected"});
+}
+
+aio::net::dgram::Listener::Listener(std::shared_ptr<Context> context, zero::ptr::RefPtr<Socket> socket)
+        : mClosed(false), mReceiving(false), mFlushing(false), mContext(std::move(context)),
+          mSocket(std::move(socket)), mWritable(zero::ptr::makeRef<ev::Event>(mContext, mSocket->fd())),
+          mBacklog(zero::ptr::makeRef<Channel<zero::ptr::RefPtr<Session>, 128>>(mContext)) {
+
+}
+
+aio::net::dgram::Listener::~Listener() {
+    if (mClosed)
+        return;
+
+    close();
+}
+
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::dgram::Session>>>
+aio::net::dgram::Listener::accept() {
+    if (mClosed)
+        return zero::async::promise::reject<zero::ptr::RefPtr<Session>>({IO_EOF, "accept on closed listener"});
+
+    if (!mReceiving) {
+        mReceiving = true;
+        receive();
+    }
+
+    return zero::async::promise::chain<zero::ptr::RefPtr<Session>>([=](const auto &p) {
+        addRef();
+
+        mBacklog->receive()->then(
+                [=](const zero::ptr::RefPtr<Session> &session) {
+                    p->resolve(session);
+                },
+                [=](const zero::async::promise::Reason &reason) {
+                    if (reason.code == IO_EOF && mError) {
+                        p->reject(*mError);
+                        return;
+                    }
+
+                    p->reject(reason);
+                }
+        );
+    })->finally([=]() {
+        release();
+    });
+}
+
+nonstd::expected<void, aio::Error> aio::net::dgram::Listener::close() {
+    if (mClosed)
+        return nonstd::make_unexpected(IO_EOF);
+
+    mClosed = true;
+
+    std::list<PendingWrite> writes = std::move(mWrites);
+    mWrites.clear();
+
+    for (const auto &write: writes)
+        write.promise->reject({IO_EOF, "datagram listener is being closed"});
+
+    if (mWritable->pending())
+        mWritable->cancel();
+
+    mSocket->close();
+    mBacklog->close();
+
+    while (mBacklog->tryReceive());
+
+    for (const auto &[key, session]: mSessions)
+        session->mChannel->close();
+
+    return {};
+}
+
+std::optional<aio::net::Address> aio::net::dgram::Listener::localAddress() {
+    return mSocket->localAddress();
+}
+
+void aio::net::dgram::Listener::receive() {
+    // the read loop holds no reference of its own: pending accepts and live sessions keep the listener alive,
+    // and the destructor closes the socket to stop the loop once they are gone.
+    zero::async::promise::doWhile([=]() {
+        return mSocket->readBatch(16, 65535)->then([=](const DatagramBatch &batch) {
+            zero::ptr::RefPtr<Listener> self(this);
+
+            for (const auto &datagram: batch.datagrams)
+                dispatch(datagram);
+        });
+    })->fail([=](const zero::async::promise::Reason &reason) {
+        if (mClosed)
+            return;
+
+        mError = reason;
+        mBacklog->close();
+
+        for (const auto &[key, session]: mSessions)
+            session->mChannel->close();
+    });
+}
+
+void aio::net::dgram::Listener::dispatch(const Datagram &datagram) {
+    auto it = mSessions.find(datagram.socketAddress);
+
+    if (it == mSessions.end()) {
+        zero::ptr::RefPtr<Session> session = zero::ptr::makeRef<Session>(
+                zero::ptr::RefPtr<Listener>(this),
+                datagram.address,
+                datagram.socketAddress
+        );
+
+        if (!mBacklog->trySend(session))
+            return;
+
+        it = mSessions.emplace(datagram.socketAddress, session.get()).first;
+    }
+
+    it->second->mChannel->trySend(std::vector<std::byte>{datagram.data.begin(), datagram.data.end()});
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>> aio::net::dgram::Listener::send(
+        nonstd::span<const std::byte> buffer,
+        const SocketAddress &address,
+        std::optional<std::chrono::milliseconds> timeout
+) {
+    if (mClosed)
+        return zero::async::promise::reject<void>({IO_EOF, "write on closed datagram listener"});
+
+    if (mWrites.empty()) {
+        nonstd::expected<void, Error> result = mSocket->trySendTo(buffer, address);
+
+        if (result)
+            return zero::async::promise::resolve<void>();
+
+        if (result.error() != IO_WOULD_BLOCK)
+            return zero::async::promise::reject<void>(
+                    {
+                            result.error(),
+                            zero::strings::format("datagram session send data failed[%s]", lastError().c_str())
+                    }
+            );
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+
+    if (timeout)
+        deadline = std::chrono::steady_clock::now() + *timeout;
+
+    return zero::async::promise::chain<void>(
+            [=, data = std::vector<std::byte>{buffer.begin(), buffer.end()}](const auto &p) {
+                mWrites.push_back({data, address, deadline, p});
+
+                if (!mFlushing)
+                    flush();
+            }
+    );
+}
+
+void aio::net::dgram::Listener::flush() {
+    mFlushing = true;
+    addRef();
+
+    zero::async::promise::loop<void>([=](const auto &loop) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::optional<std::chrono::milliseconds> wait;
+
+        for (auto it = mWrites.begin(); it != mWrites.end();) {
+            if (!it->deadline) {
+                it++;
+                continue;
+            }
+
+            if (*it->deadline <= now) {
+                std::shared_ptr<zero::async::promise::Promise<void>> promise = it->promise;
+
+                it = mWrites.erase(it);
+                promise->reject({IO_TIMEOUT, "datagram session write timed out"});
+
+                continue;
+            }
+
+            auto remain = (std::max)(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(*it->deadline - now),
+                    std::chrono::milliseconds{1}
+            );
+
+            wait = wait ? (std::min)(*wait, remain) : remain;
+            it++;
+        }
+
+        while (!mWrites.empty()) {
+            PendingWrite &write = mWrites.front();
+            nonstd::expected<void, Error> result = mSocket->trySendTo(write.data, write.address);
+
+            if (!result && result.error() == IO_WOULD_BLOCK)
+                break;
+
+            std::shared_ptr<zero::async::promise::Promise<void>> promise = write.promise;
+            mWrites.pop_front();
+
+            if (!result) {
+                promise->reject(
+                        {
+                                result.error(),
+                                zero::strings::format("datagram session send data failed[%s]", lastError().c_str())
+                        }
+                );
+
+                continue;
+            }
+
+            promise->resolve();
+        }
+
+        if (mWrites.empty()) {
+            P_BREAK(loop);
+            return;
+        }
+
+        mWritable->on(ev::WRITE, wait)->then([=](short) {
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            P_BREAK_E(loop, reason);
+        });
+    })->fail([=](const zero::async::promise::Reason &reason) {
+        std::list<PendingWrite> writes = std::move(mWrites);
+        mWrites.clear();
+
+        for (const auto &write: writes)
+            write.promise->reject(reason);
+    })->finally([=]() {
+        mFlushing = false;
+        release();
+    });
+}
+
 zero::ptr::RefPtr<aio::net::dgram::Socket>
 aio::net::dgram::bind(const std::shared_ptr<Context> &context, const Address &address) {
     zero::ptr::RefPtr<Socket> socket = newSocket(context, address.index() == 0 ? AF_INET : AF_INET6);
@@ -523,6 +1499,26 @@ aio::net::dgram::connect(const std::shared_ptr<Context> &context, const std::str
     });
 }
 
+zero::ptr::RefPtr<aio::net::dgram::Listener>
+aio::net::dgram::listen(const std::shared_ptr<Context> &context, const Address &address) {
+    zero::ptr::RefPtr<Socket> socket = dgram::bind(context, address);
+
+    if (!socket)
+        return nullptr;
+
+    return zero::ptr::makeRef<Listener>(context, socket);
+}
+
+zero::ptr::RefPtr<aio::net::dgram::Listener>
+aio::net::dgram::listen(const std::shared_ptr<Context> &context, const std::string &ip, unsigned short port) {
+    std::optional<Address> address = IPAddressFrom(ip, port);
+
+    if (!address)
+        return nullptr;
+
+    return dgram::listen(context, *address);
+}
+
 zero::ptr::RefPtr<aio::net::dgram::Socket>
 aio::net::dgram::newSocket(const std::shared_ptr<Context> &context, int family) {
     auto fd = (evutil_socket_t) socket(family, SOCK_DGRAM, 0);
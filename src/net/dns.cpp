@@ -2,7 +2,150 @@
 #include <event2/dns.h>
 #include <zero/strings/strings.h>
 
-std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> aio::net::dns::getAddressInfo(
+aio::net::dns::Cache::Cache(const CacheConfig &config) : mConfig(config) {
+
+}
+
+std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> aio::net::dns::Cache::getAddressInfo(
+        const std::shared_ptr<Context> &context,
+        const std::string &node,
+        const std::optional<std::string> &service,
+        const std::optional<evutil_addrinfo> &hints
+) {
+    if (IPAddressFrom(node, 0))
+        return query(context, node, service, hints);
+
+    std::string key = node;
+
+    key.push_back('\0');
+
+    if (service)
+        key.append(*service);
+
+    key.push_back('\0');
+
+    if (hints)
+        key.append(
+                zero::strings::format(
+                        "%d:%d:%d:%d",
+                        hints->ai_flags,
+                        hints->ai_family,
+                        hints->ai_socktype,
+                        hints->ai_protocol
+                )
+        );
+
+    std::optional<nonstd::expected<std::vector<Address>, zero::async::promise::Reason>> result = find(key);
+
+    if (result) {
+        if (!*result)
+            return zero::async::promise::reject<std::vector<Address>>(result->error());
+
+        return zero::async::promise::resolve<std::vector<Address>>(std::move(**result));
+    }
+
+    return zero::async::promise::chain<std::vector<Address>>([=](const auto &p) {
+        auto it = mPending.find(key);
+
+        if (it != mPending.end()) {
+            it->second.push_back(p);
+            return;
+        }
+
+        mPending[key].push_back(p);
+
+        query(context, node, service, hints)->then(
+                [=, self = shared_from_this()](nonstd::span<const Address> addresses) {
+                    complete(key, std::vector<Address>{addresses.begin(), addresses.end()});
+                },
+                [=, self = shared_from_this()](const zero::async::promise::Reason &reason) {
+                    complete(key, nonstd::make_unexpected(reason));
+                }
+        );
+    });
+}
+
+size_t aio::net::dns::Cache::size() const {
+    return mEntries.size();
+}
+
+void aio::net::dns::Cache::clear() {
+    mIndex.clear();
+    mEntries.clear();
+}
+
+std::optional<nonstd::expected<std::vector<aio::net::Address>, zero::async::promise::Reason>>
+aio::net::dns::Cache::find(const std::string &key) {
+    auto it = mIndex.find(key);
+
+    if (it == mIndex.end())
+        return std::nullopt;
+
+    if (std::chrono::steady_clock::now() >= it->second->expiry) {
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+        return std::nullopt;
+    }
+
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->result;
+}
+
+void aio::net::dns::Cache::insert(
+        const std::string &key,
+        nonstd::expected<std::vector<Address>, zero::async::promise::Reason> result
+) {
+    std::chrono::seconds ttl = result ? mConfig.ttl : mConfig.negativeTTL;
+
+    if (mConfig.maxSize == 0 || ttl.count() <= 0)
+        return;
+
+    auto it = mIndex.find(key);
+
+    if (it != mIndex.end()) {
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+    }
+
+    mEntries.push_front({key, std::chrono::steady_clock::now() + ttl, std::move(result)});
+    mIndex[key] = mEntries.begin();
+
+    while (mEntries.size() > mConfig.maxSize) {
+        mIndex.erase(mEntries.back().key);
+        mEntries.pop_back();
+    }
+}
+
+void aio::net::dns::Cache::complete(
+        const std::string &key,
+        const nonstd::expected<std::vector<Address>, zero::async::promise::Reason> &result
+) {
+    auto it = mPending.find(key);
+
+    if (it == mPending.end())
+        return;
+
+    std::list<std::shared_ptr<zero::async::promise::Promise<std::vector<Address>>>> pending = std::move(it->second);
+    mPending.erase(it);
+
+    if (result || result.error().code == DNS_NO_RECORD)
+        insert(key, result);
+
+    for (const auto &p: pending) {
+        if (!result) {
+            p->reject(result.error());
+            continue;
+        }
+
+        p->resolve(*result);
+    }
+}
+
+std::shared_ptr<aio::net::dns::Cache> aio::net::dns::newCache(const CacheConfig &config) {
+    return std::make_shared<Cache>(config);
+}
+
+std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> aio::net::dns::query(
         const std::shared_ptr<Context> &context,
         const std::string &node,
         const std::optional<std::string> &service,
@@ -19,6 +162,12 @@ std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> a
                 [](int result, evutil_addrinfo *res, void *arg) {
                     auto p = (std::shared_ptr<zero::async::promise::Promise<std::vector<Address>>> *) arg;
 
+                    if (result == EVUTIL_EAI_NONAME) {
+                        p->operator*().reject({DNS_NO_RECORD, "DNS record not found"});
+                        delete p;
+                        return;
+                    }
+
                     if (result != 0) {
                         p->operator*().reject(
                                 {DNS_RESOLVE_ERROR, zero::strings::format("DNS resolve failed[%d]", result)}
@@ -39,6 +188,8 @@ std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> a
                         addresses.push_back(std::move(*address));
                     }
 
+                    evutil_freeaddrinfo(res);
+
                     if (addresses.empty()) {
                         p->operator*().reject({DNS_NO_RECORD, "DNS record not found"});
                         delete p;
@@ -53,6 +204,20 @@ std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> a
     });
 }
 
+std::shared_ptr<zero::async::promise::Promise<std::vector<aio::net::Address>>> aio::net::dns::getAddressInfo(
+        const std::shared_ptr<Context> &context,
+        const std::string &node,
+        const std::optional<std::string> &service,
+        const std::optional<evutil_addrinfo> &hints
+) {
+    std::shared_ptr<Cache> cache = context->dnsCache();
+
+    if (!cache)
+        return query(context, node, service, hints);
+
+    return cache->getAddressInfo(context, node, service, hints);
+}
+
 std::shared_ptr<zero::async::promise::Promise<std::vector<std::variant<std::array<std::byte, 4>, std::array<std::byte, 16>>>>>
 aio::net::dns::lookupIP(const std::shared_ptr<Context> &context, const std::string &host) {
     evutil_addrinfo hints = {};
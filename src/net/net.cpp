@@ -2,6 +2,7 @@
 #include <zero/os/net.h>
 #include <zero/strings/strings.h>
 #include <cstring>
+#include <limits>
 
 #ifdef _WIN32
 #include <netioapi.h>
@@ -14,6 +15,10 @@
 #include <sys/un.h>
 #endif
 
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#endif
+
 bool aio::net::operator==(const aio::net::IPv4Address &lhs, const aio::net::IPv4Address &rhs) {
     return lhs.port == rhs.port && lhs.ip == rhs.ip;
 }
@@ -68,6 +73,14 @@ bool aio::net::operator!=(const aio::net::Address &lhs, const aio::net::Address
     return !operator==(lhs, rhs);
 }
 
+bool aio::net::operator==(const aio::net::SocketAddress &lhs, const aio::net::SocketAddress &rhs) {
+    return lhs.length == rhs.length && memcmp(&lhs.storage, &rhs.storage, lhs.length) == 0;
+}
+
+bool aio::net::operator!=(const aio::net::SocketAddress &lhs, const aio::net::SocketAddress &rhs) {
+    return !operator==(lhs, rhs);
+}
+
 std::string aio::net::stringify(const aio::net::IPv4Address &ipv4Address) {
     return zero::os::net::stringify(ipv4Address.ip) + ":" + std::to_string(ipv4Address.port);
 }
@@ -176,6 +189,10 @@ std::optional<aio::net::Address> aio::net::addressFrom(const sockaddr *socketAdd
     return address;
 }
 
+std::optional<aio::net::Address> aio::net::addressFrom(const SocketAddress &socketAddress) {
+    return addressFrom((const sockaddr *) &socketAddress.storage);
+}
+
 std::optional<aio::net::Address> aio::net::IPAddressFrom(const std::string &ip, unsigned short port) {
     std::optional<aio::net::Address> address = IPv6AddressFrom(ip, port);
 
@@ -212,8 +229,8 @@ std::optional<aio::net::Address> aio::net::IPv6AddressFrom(const std::string &ip
     return IPv6Address{port, ipv6, name};
 }
 
-std::optional<std::vector<std::byte>> aio::net::socketAddressFrom(const Address &address) {
-    std::optional<std::vector<std::byte>> socketAddress;
+std::optional<aio::net::SocketAddress> aio::net::socketAddressFrom(const Address &address) {
+    std::optional<SocketAddress> socketAddress;
 
     switch (address.index()) {
         case 0: {
@@ -224,10 +241,8 @@ std::optional<std::vector<std::byte>> aio::net::socketAddressFrom(const Address
             addr.sin_port = htons(ipv4.port);
             memcpy(&addr.sin_addr, ipv4.ip.data(), sizeof(in_addr));
 
-            socketAddress = std::vector<std::byte>{
-                    (const std::byte *) &addr,
-                    (const std::byte *) &addr + sizeof(sockaddr_in)
-            };
+            socketAddress = SocketAddress{{}, sizeof(sockaddr_in)};
+            memcpy(&socketAddress->storage, &addr, sizeof(sockaddr_in));
 
             break;
         }
@@ -240,25 +255,17 @@ std::optional<std::vector<std::byte>> aio::net::socketAddressFrom(const Address
             addr.sin6_port = htons(ipv6.port);
             memcpy(&addr.sin6_addr, ipv6.ip.data(), sizeof(in6_addr));
 
-            if (!ipv6.zone) {
-                socketAddress = std::vector<std::byte>{
-                        (const std::byte *) &addr,
-                        (const std::byte *) &addr + sizeof(sockaddr_in6)
-                };
-
-                break;
-            }
+            if (ipv6.zone) {
+                unsigned int index = if_nametoindex(ipv6.zone->c_str());
 
-            unsigned int index = if_nametoindex(ipv6.zone->c_str());
+                if (!index)
+                    break;
 
-            if (!index)
-                break;
+                addr.sin6_scope_id = index;
+            }
 
-            addr.sin6_scope_id = index;
-            socketAddress = std::vector<std::byte>{
-                    (const std::byte *) &addr,
-                    (const std::byte *) &addr + sizeof(sockaddr_in6)
-            };
+            socketAddress = SocketAddress{{}, sizeof(sockaddr_in6)};
+            memcpy(&socketAddress->storage, &addr, sizeof(sockaddr_in6));
 
             break;
         }
@@ -270,10 +277,8 @@ std::optional<std::vector<std::byte>> aio::net::socketAddressFrom(const Address
             addr.sun_family = AF_UNIX;
             strncpy(addr.sun_path, std::get<UnixAddress>(address).path.c_str(), sizeof(addr.sun_path) - 1);
 
-            socketAddress = std::vector<std::byte>{
-                    (const std::byte *) &addr,
-                    (const std::byte *) &addr + sizeof(sockaddr_un)
-            };
+            socketAddress = SocketAddress{{}, sizeof(sockaddr_un)};
+            memcpy(&socketAddress->storage, &addr, sizeof(sockaddr_un));
 
             break;
         }
@@ -285,3 +290,215 @@ std::optional<std::vector<std::byte>> aio::net::socketAddressFrom(const Address
 
     return socketAddress;
 }
+
+std::optional<aio::net::SocketAddress> aio::net::socketAddressFrom(const sockaddr *addr, socklen_t length) {
+    if (length == 0 || length > sizeof(sockaddr_storage))
+        return std::nullopt;
+
+    SocketAddress socketAddress = {{}, length};
+    memcpy(&socketAddress.storage, addr, length);
+
+    return socketAddress;
+}
+
+std::vector<aio::net::Address> aio::net::interleave(nonstd::span<const Address> addresses) {
+    if (addresses.empty())
+        return {};
+
+    std::vector<Address> primary;
+    std::vector<Address> secondary;
+
+    for (const auto &address: addresses) {
+        if (address.index() == addresses.front().index()) {
+            primary.push_back(address);
+            continue;
+        }
+
+        secondary.push_back(address);
+    }
+
+    std::vector<Address> result;
+
+    for (size_t i = 0; i < std::max(primary.size(), secondary.size()); i++) {
+        if (i < primary.size())
+            result.push_back(std::move(primary[i]));
+
+        if (i < secondary.size())
+            result.push_back(std::move(secondary[i]));
+    }
+
+    return result;
+}
+
+nonstd::expected<void, aio::Error> aio::net::setSocketOptions(evutil_socket_t fd, const SocketOptions &options) {
+    if ((options.sendBuffer && *options.sendBuffer <= 0) || (options.receiveBuffer && *options.receiveBuffer <= 0))
+        return nonstd::make_unexpected(INVALID_ARGUMENT);
+
+    if ((options.notSentLowAt && *options.notSentLowAt < 0) || (options.fastOpen && *options.fastOpen < 0))
+        return nonstd::make_unexpected(INVALID_ARGUMENT);
+
+    if (options.busyPoll &&
+        (options.busyPoll->count() < 0 || options.busyPoll->count() > (std::numeric_limits<int>::max)()))
+        return nonstd::make_unexpected(INVALID_ARGUMENT);
+
+    if (options.keepAlive &&
+        (options.keepAlive->idle.count() <= 0 || options.keepAlive->idle.count() > (std::numeric_limits<int>::max)() ||
+         options.keepAlive->interval.count() <= 0 ||
+         options.keepAlive->interval.count() > (std::numeric_limits<int>::max)() ||
+         options.keepAlive->count <= 0))
+        return nonstd::make_unexpected(INVALID_ARGUMENT);
+
+    if (options.incomingCPU && *options.incomingCPU < 0)
+        return nonstd::make_unexpected(INVALID_ARGUMENT);
+
+#ifndef TCP_QUICKACK
+    if (options.quickAck)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+#if !defined(TCP_CORK) && !defined(TCP_NOPUSH)
+    if (options.cork)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+#ifndef TCP_NOTSENT_LOWAT
+    if (options.notSentLowAt)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+#ifndef SO_BUSY_POLL
+    if (options.busyPoll)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+#ifndef TCP_FASTOPEN
+    if (options.fastOpen)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+#if (!defined(TCP_KEEPIDLE) && !defined(TCP_KEEPALIVE)) || !defined(TCP_KEEPINTVL) || !defined(TCP_KEEPCNT)
+    if (options.keepAlive)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+#ifndef SO_INCOMING_CPU
+    if (options.incomingCPU)
+        return nonstd::make_unexpected(IO_NOT_SUPPORTED);
+#endif
+
+    auto set = [=](int level, int name, int value) -> nonstd::expected<void, Error> {
+        if (setsockopt(fd, level, name, (const char *) &value, sizeof(value)) != 0)
+            return nonstd::make_unexpected(IO_ERROR);
+
+        return {};
+    };
+
+    nonstd::expected<void, Error> result;
+
+    if (options.noDelay) {
+        result = set(IPPROTO_TCP, TCP_NODELAY, *options.noDelay);
+
+        if (!result)
+            return result;
+    }
+
+#ifdef TCP_QUICKACK
+    if (options.quickAck) {
+        result = set(IPPROTO_TCP, TCP_QUICKACK, *options.quickAck);
+
+        if (!result)
+            return result;
+    }
+#endif
+
+#if defined(TCP_CORK) || defined(TCP_NOPUSH)
+    if (options.cork) {
+#ifdef TCP_CORK
+        result = set(IPPROTO_TCP, TCP_CORK, *options.cork);
+#else
+        result = set(IPPROTO_TCP, TCP_NOPUSH, *options.cork);
+#endif
+        if (!result)
+            return result;
+    }
+#endif
+
+    if (options.sendBuffer) {
+        result = set(SOL_SOCKET, SO_SNDBUF, *options.sendBuffer);
+
+        if (!result)
+            return result;
+    }
+
+    if (options.receiveBuffer) {
+        result = set(SOL_SOCKET, SO_RCVBUF, *options.receiveBuffer);
+
+        if (!result)
+            return result;
+    }
+
+#ifdef TCP_NOTSENT_LOWAT
+    if (options.notSentLowAt) {
+        result = set(IPPROTO_TCP, TCP_NOTSENT_LOWAT, *options.notSentLowAt);
+
+        if (!result)
+            return result;
+    }
+#endif
+
+#ifdef SO_BUSY_POLL
+    if (options.busyPoll) {
+        result = set(SOL_SOCKET, SO_BUSY_POLL, (int) options.busyPoll->count());
+
+        if (!result)
+            return result;
+    }
+#endif
+
+#ifdef TCP_FASTOPEN
+    if (options.fastOpen) {
+        result = set(IPPROTO_TCP, TCP_FASTOPEN, *options.fastOpen);
+
+        if (!result)
+            return result;
+    }
+#endif
+
+#if (defined(TCP_KEEPIDLE) || defined(TCP_KEEPALIVE)) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+    if (options.keepAlive) {
+        result = set(SOL_SOCKET, SO_KEEPALIVE, 1);
+
+        if (!result)
+            return result;
+
+#ifdef TCP_KEEPIDLE
+        result = set(IPPROTO_TCP, TCP_KEEPIDLE, (int) options.keepAlive->idle.count());
+#else
+        result = set(IPPROTO_TCP, TCP_KEEPALIVE, (int) options.keepAlive->idle.count());
+#endif
+        if (!result)
+            return result;
+
+        result = set(IPPROTO_TCP, TCP_KEEPINTVL, (int) options.keepAlive->interval.count());
+
+        if (!result)
+            return result;
+
+        result = set(IPPROTO_TCP, TCP_KEEPCNT, options.keepAlive->count);
+
+        if (!result)
+            return result;
+    }
+#endif
+
+#ifdef SO_INCOMING_CPU
+    if (options.incomingCPU) {
+        result = set(SOL_SOCKET, SO_INCOMING_CPU, *options.incomingCPU);
+
+        if (!result)
+            return result;
+    }
+#endif
+
+    return {};
+}
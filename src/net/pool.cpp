@@ -0,0 +1,215 @@
+#include <aio/net/pool.h>
+#include <zero/strings/strings.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <cerrno>
+#include <sys/socket.h>
+#endif
+
+aio::net::ConnectionPool::ConnectionPool(std::shared_ptr<Context> context, const PoolConfig &config)
+        : mConfig(config), mContext(std::move(context)), mTimer(zero::ptr::makeRef<ev::Timer>(mContext)) {
+
+}
+
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
+aio::net::ConnectionPool::acquire(const Endpoint &endpoint) {
+    auto it = mIdle.find(key(endpoint));
+
+    if (it == mIdle.end())
+        return connect(endpoint);
+
+    auto now = std::chrono::steady_clock::now();
+
+    while (!it->second.empty()) {
+        Connection connection = std::move(it->second.front());
+        it->second.pop_front();
+
+        if (mConfig.idleTimeout.count() > 0 && now - connection.since >= mConfig.idleTimeout) {
+            connection.buffer->close();
+            continue;
+        }
+
+        if (!healthy(connection.buffer)) {
+            connection.buffer->close();
+            continue;
+        }
+
+        if (it->second.empty())
+            mIdle.erase(it);
+
+        return zero::async::promise::resolve<zero::ptr::RefPtr<stream::IBuffer>>(std::move(connection.buffer));
+    }
+
+    mIdle.erase(it);
+    return connect(endpoint);
+}
+
+void aio::net::ConnectionPool::recycle(const Endpoint &endpoint, zero::ptr::RefPtr<stream::IBuffer> buffer) {
+    if (!healthy(buffer) || buffer->pending() > 0) {
+        buffer->close();
+        return;
+    }
+
+    std::list<Connection> &connections = mIdle[key(endpoint)];
+
+    if (connections.size() >= mConfig.maxIdle) {
+        buffer->close();
+
+        if (connections.empty())
+            mIdle.erase(key(endpoint));
+
+        return;
+    }
+
+    buffer->setTimeout(std::chrono::milliseconds::zero());
+    connections.push_front({std::move(buffer), std::chrono::steady_clock::now()});
+
+    schedule();
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>>
+aio::net::ConnectionPool::prewarm(const Endpoint &endpoint, size_t count) {
+    if (count == 0)
+        return zero::async::promise::resolve<void>();
+
+    addRef();
+
+    return zero::async::promise::chain<void>([=](const auto &p) {
+        std::shared_ptr<size_t> remaining = std::make_shared<size_t>(count);
+        std::shared_ptr<std::optional<zero::async::promise::Reason>> failure = std::make_shared<
+                std::optional<zero::async::promise::Reason>
+        >();
+
+        for (size_t i = 0; i < count; i++) {
+            connect(endpoint)->then([=](const zero::ptr::RefPtr<stream::IBuffer> &buffer) {
+                recycle(endpoint, buffer);
+            }, [=](const zero::async::promise::Reason &reason) {
+                *failure = reason;
+            })->finally([=]() {
+                if (--*remaining > 0)
+                    return;
+
+                if (*failure) {
+                    p->reject(**failure);
+                    return;
+                }
+
+                p->resolve();
+            });
+        }
+    })->finally([=]() {
+        release();
+    });
+}
+
+size_t aio::net::ConnectionPool::idle(const Endpoint &endpoint) {
+    auto it = mIdle.find(key(endpoint));
+
+    if (it == mIdle.end())
+        return 0;
+
+    return it->second.size();
+}
+
+void aio::net::ConnectionPool::clear() {
+    for (auto &[key, connections]: mIdle) {
+        for (auto &connection: connections)
+            connection.buffer->close();
+    }
+
+    mIdle.clear();
+    mTimer->cancel();
+}
+
+std::string aio::net::ConnectionPool::key(const Endpoint &endpoint) {
+#ifndef AIO_DISABLE_SSL
+    return zero::strings::format("%s:%hu:%p", endpoint.host.c_str(), endpoint.port, endpoint.ctx.get());
+#else
+    return zero::strings::format("%s:%hu", endpoint.host.c_str(), endpoint.port);
+#endif
+}
+
+bool aio::net::ConnectionPool::healthy(const zero::ptr::RefPtr<stream::IBuffer> &buffer) {
+    nonstd::expected<std::vector<std::byte>, Error> data = buffer->tryPeek(1);
+
+    if (data || data.error() != IO_WOULD_BLOCK)
+        return false;
+
+#ifndef AIO_DISABLE_SSL
+    auto tls = dynamic_cast<ssl::stream::Buffer *>(buffer.get());
+
+    if (tls)
+        return tls->alive();
+#endif
+
+    evutil_socket_t fd = buffer->fd();
+
+    if (fd == EVUTIL_INVALID_SOCKET)
+        return false;
+
+    char c;
+    int n = recv(fd, &c, 1, MSG_PEEK);
+
+    if (n >= 0)
+        return false;
+
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
+aio::net::ConnectionPool::connect(const Endpoint &endpoint) {
+#ifndef AIO_DISABLE_SSL
+    if (endpoint.ctx)
+        return ssl::stream::connect(mContext, endpoint.host, endpoint.port, endpoint.ctx);
+#endif
+    return stream::connect(mContext, endpoint.host, endpoint.port);
+}
+
+void aio::net::ConnectionPool::sweep() {
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto it = mIdle.begin(); it != mIdle.end();) {
+        std::list<Connection> &connections = it->second;
+
+        while (!connections.empty() && now - connections.back().since >= mConfig.idleTimeout) {
+            connections.back().buffer->close();
+            connections.pop_back();
+        }
+
+        if (connections.empty()) {
+            it = mIdle.erase(it);
+            continue;
+        }
+
+        it++;
+    }
+}
+
+void aio::net::ConnectionPool::schedule() {
+    if (mIdle.empty() || mConfig.idleTimeout.count() <= 0 || mTimer->pending())
+        return;
+
+    std::chrono::steady_clock::time_point oldest = std::chrono::steady_clock::time_point::max();
+
+    for (const auto &[key, connections]: mIdle)
+        oldest = (std::min)(oldest, connections.back().since);
+
+    auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+            oldest + mConfig.idleTimeout - std::chrono::steady_clock::now()
+    );
+
+    addRef();
+
+    mTimer->setTimeout((std::max)(delay, std::chrono::milliseconds{1}))->then([=]() {
+        sweep();
+        schedule();
+    })->finally([=]() {
+        release();
+    });
+}
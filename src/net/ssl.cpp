@@ -1,9 +1,12 @@
 #include <aio/net/ssl.h>
+#include <aio/net/dns.h>
+#include <aio/thread.h>
 #include <aio/error.h>
 #include <zero/os/net.h>
 #include <zero/strings/strings.h>
 #include <cstring>
 #include <openssl/err.h>
+#include <openssl/rand.h>
 #include <openssl/x509v3.h>
 #include <event2/bufferevent_ssl.h>
 
@@ -11,32 +14,50 @@
 #include <netinet/in.h>
 #endif
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+#define AIO_KTLS
+#endif
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
+
 #ifdef AIO_EMBED_CA_CERT
 #include <cacert.h>
 
 bool aio::net::ssl::loadEmbeddedCA(Context *ctx) {
-    BIO *bio = BIO_new_mem_buf(CA_CERT, (int) sizeof(CA_CERT));
+    static std::shared_ptr<STACK_OF(X509_INFO)> certificates = []() -> std::shared_ptr<STACK_OF(X509_INFO)> {
+        BIO *bio = BIO_new_mem_buf(CA_CERT, (int) sizeof(CA_CERT));
 
-    if (!bio)
-        return false;
+        if (!bio)
+            return nullptr;
 
-    STACK_OF(X509_INFO) *info = PEM_X509_INFO_read_bio(bio, nullptr, nullptr, nullptr);
-
-    if (!info) {
+        STACK_OF(X509_INFO) *info = PEM_X509_INFO_read_bio(bio, nullptr, nullptr, nullptr);
         BIO_free(bio);
+
+        if (!info)
+            return nullptr;
+
+        return {
+                info,
+                [](STACK_OF(X509_INFO) *info) {
+                    sk_X509_INFO_pop_free(info, X509_INFO_free);
+                }
+        };
+    }();
+
+    if (!certificates)
         return false;
-    }
 
-    X509_STORE *store = SSL_CTX_get_cert_store(ctx);
+    X509_STORE *store = X509_STORE_new();
 
-    if (!store) {
-        sk_X509_INFO_pop_free(info, X509_INFO_free);
-        BIO_free(bio);
+    if (!store)
         return false;
-    }
 
-    for (int i = 0; i < sk_X509_INFO_num(info); i++) {
-        X509_INFO *item = sk_X509_INFO_value(info, i);
+    for (int i = 0; i < sk_X509_INFO_num(certificates.get()); i++) {
+        X509_INFO *item = sk_X509_INFO_value(certificates.get(), i);
 
         if (item->x509)
             X509_STORE_add_cert(store, item->x509);
@@ -45,9 +66,14 @@ bool aio::net::ssl::loadEmbeddedCA(Context *ctx) {
             X509_STORE_add_crl(store, item->crl);
     }
 
-    sk_X509_INFO_pop_free(info, X509_INFO_free);
-    BIO_free(bio);
+    X509_STORE *previous = SSL_CTX_get_cert_store(ctx);
 
+    if (previous && !X509_VERIFY_PARAM_set1(X509_STORE_get0_param(store), X509_STORE_get0_param(previous))) {
+        X509_STORE_free(store);
+        return false;
+    }
+
+    SSL_CTX_set_cert_store(ctx, store);
     return true;
 }
 #endif
@@ -97,6 +123,151 @@ std::string aio::net::ssl::getError(unsigned long e) {
     return buffer;
 }
 
+aio::net::ssl::SessionCache::SessionCache(size_t maxSize) : mMaxSize(maxSize) {
+
+}
+
+aio::net::ssl::SessionCache::~SessionCache() {
+    for (const auto &entry: mEntries)
+        SSL_SESSION_free(entry.session);
+}
+
+SSL_SESSION *aio::net::ssl::SessionCache::get(const std::string &host) {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    auto it = mIndex.find(host);
+
+    if (it == mIndex.end())
+        return nullptr;
+
+    if (!SSL_SESSION_is_resumable(it->second->session)) {
+        SSL_SESSION_free(it->second->session);
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+        return nullptr;
+    }
+
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+
+    SSL_SESSION_up_ref(it->second->session);
+    return it->second->session;
+}
+
+void aio::net::ssl::SessionCache::set(const std::string &host, SSL_SESSION *session) {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    auto it = mIndex.find(host);
+
+    if (it != mIndex.end()) {
+        SSL_SESSION_free(it->second->session);
+        it->second->session = session;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return;
+    }
+
+    mEntries.push_front({host, session});
+    mIndex[host] = mEntries.begin();
+
+    while (mEntries.size() > mMaxSize) {
+        SSL_SESSION_free(mEntries.back().session);
+        mIndex.erase(mEntries.back().host);
+        mEntries.pop_back();
+    }
+}
+
+void aio::net::ssl::SessionCache::remove(const std::string &host) {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    auto it = mIndex.find(host);
+
+    if (it == mIndex.end())
+        return;
+
+    SSL_SESSION_free(it->second->session);
+    mEntries.erase(it->second);
+    mIndex.erase(it);
+}
+
+int aio::net::ssl::SessionCache::index() {
+    static int index = SSL_CTX_get_ex_new_index(
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            [](void *parent, void *ptr, CRYPTO_EX_DATA *ad, int idx, long argl, void *argp) {
+                delete (SessionCache *) ptr;
+            }
+    );
+
+    return index;
+}
+
+aio::net::ssl::TicketKeyRing::TicketKeyRing(std::chrono::seconds rotation) : mRotation(rotation) {
+
+}
+
+std::optional<aio::net::ssl::TicketKey> aio::net::ssl::TicketKeyRing::current() {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mKeys.empty() || std::chrono::steady_clock::now() - mKeys.front().created >= mRotation) {
+        std::optional<TicketKey> key = generate();
+
+        if (!key) {
+            if (mKeys.empty())
+                return std::nullopt;
+
+            return mKeys.front();
+        }
+
+        mKeys.push_front(*key);
+
+        if (mKeys.size() > 2)
+            mKeys.pop_back();
+    }
+
+    return mKeys.front();
+}
+
+std::optional<std::pair<aio::net::ssl::TicketKey, bool>>
+aio::net::ssl::TicketKeyRing::find(const unsigned char *name) {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    auto it = std::find_if(mKeys.begin(), mKeys.end(), [=](const auto &key) {
+        return memcmp(key.name.data(), name, key.name.size()) == 0;
+    });
+
+    if (it == mKeys.end() || std::chrono::steady_clock::now() - it->created >= 2 * mRotation)
+        return std::nullopt;
+
+    return std::pair{*it, it != mKeys.begin()};
+}
+
+int aio::net::ssl::TicketKeyRing::index() {
+    static int index = SSL_CTX_get_ex_new_index(
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            [](void *parent, void *ptr, CRYPTO_EX_DATA *ad, int idx, long argl, void *argp) {
+                delete (TicketKeyRing *) ptr;
+            }
+    );
+
+    return index;
+}
+
+std::optional<aio::net::ssl::TicketKey> aio::net::ssl::TicketKeyRing::generate() {
+    TicketKey key = {};
+
+    if (RAND_bytes(key.name.data(), (int) key.name.size()) != 1 ||
+        RAND_bytes(key.aesKey.data(), (int) key.aesKey.size()) != 1 ||
+        RAND_bytes(key.hmacKey.data(), (int) key.hmacKey.size()) != 1)
+        return std::nullopt;
+
+    key.created = std::chrono::steady_clock::now();
+    return key;
+}
+
 std::shared_ptr<aio::net::ssl::Context> aio::net::ssl::newContext(const Config &config) {
     std::shared_ptr<Context> ctx = std::shared_ptr<Context>(
             SSL_CTX_new(TLS_method()),
@@ -114,6 +285,81 @@ std::shared_ptr<aio::net::ssl::Context> aio::net::ssl::newContext(const Config &
     if (!SSL_CTX_set_max_proto_version(ctx.get(), config.minVersion.value_or(TLS_VERSION_1_3)))
         return nullptr;
 
+#ifdef AIO_KTLS
+    if (config.ktls)
+        SSL_CTX_set_options(ctx.get(), SSL_OP_ENABLE_KTLS);
+#endif
+
+    if (!config.alpn.empty()) {
+        static int index = SSL_CTX_get_ex_new_index(
+                0,
+                nullptr,
+                nullptr,
+                nullptr,
+                [](void *parent, void *ptr, CRYPTO_EX_DATA *ad, int idx, long argl, void *argp) {
+                    delete (std::vector<unsigned char> *) ptr;
+                }
+        );
+
+        auto protocols = new std::vector<unsigned char>();
+
+        for (const auto &protocol: config.alpn) {
+            if (protocol.empty() || protocol.size() > 255) {
+                delete protocols;
+                return nullptr;
+            }
+
+            protocols->push_back((unsigned char) protocol.size());
+            protocols->insert(protocols->end(), protocol.begin(), protocol.end());
+        }
+
+        if (!config.server) {
+            int n = SSL_CTX_set_alpn_protos(ctx.get(), protocols->data(), (unsigned int) protocols->size());
+            delete protocols;
+
+            if (n != 0)
+                return nullptr;
+        } else {
+            if (!SSL_CTX_set_ex_data(ctx.get(), index, protocols)) {
+                delete protocols;
+                return nullptr;
+            }
+
+            SSL_CTX_set_alpn_select_cb(
+                    ctx.get(),
+                    [](
+                            SSL *ssl,
+                            const unsigned char **out,
+                            unsigned char *length,
+                            const unsigned char *in,
+                            unsigned int size,
+                            void *
+                    ) {
+                        auto protocols = (std::vector<unsigned char> *) SSL_CTX_get_ex_data(
+                                SSL_get_SSL_CTX(ssl),
+                                index
+                        );
+
+                        if (!protocols)
+                            return SSL_TLSEXT_ERR_NOACK;
+
+                        if (SSL_select_next_proto(
+                                (unsigned char **) out,
+                                length,
+                                protocols->data(),
+                                (unsigned int) protocols->size(),
+                                in,
+                                size
+                        ) != OPENSSL_NPN_NEGOTIATED)
+                            return SSL_TLSEXT_ERR_ALERT_FATAL;
+
+                        return SSL_TLSEXT_ERR_OK;
+                    },
+                    nullptr
+            );
+        }
+    }
+
     switch (config.ca.index()) {
         case 1: {
             X509 *cert = readCertificate(std::get<1>(config.ca));
@@ -220,9 +466,337 @@ std::shared_ptr<aio::net::ssl::Context> aio::net::ssl::newContext(const Config &
             nullptr
     );
 
+    if (!config.server && config.sessionCacheSize > 0) {
+        auto cache = new SessionCache(config.sessionCacheSize);
+
+        if (!SSL_CTX_set_ex_data(ctx.get(), SessionCache::index(), cache)) {
+            delete cache;
+            return nullptr;
+        }
+
+        SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx.get(), [](SSL *ssl, SSL_SESSION *session) {
+            auto cache = (SessionCache *) SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), SessionCache::index());
+            const char *host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+
+            if (!cache || !host)
+                return 0;
+
+            cache->set(host, session);
+            return 1;
+        });
+    }
+
+    if (config.server && config.sessionCacheSize > 0) {
+        SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(ctx.get(), (long) config.sessionCacheSize);
+
+        if (!SSL_CTX_set_session_id_context(ctx.get(), (const unsigned char *) "aio", 3))
+            return nullptr;
+    }
+
+    if (config.server && config.ticketKeyRotation) {
+        if (config.ticketKeyRotation->count() <= 0)
+            return nullptr;
+
+        auto ring = new TicketKeyRing(*config.ticketKeyRotation);
+
+        if (!SSL_CTX_set_ex_data(ctx.get(), TicketKeyRing::index(), ring)) {
+            delete ring;
+            return nullptr;
+        }
+
+        SSL_CTX_set_timeout(ctx.get(), (long) (2 * *config.ticketKeyRotation).count());
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(
+                ctx.get(),
+                [](
+                        SSL *ssl,
+                        unsigned char *name,
+                        unsigned char *iv,
+                        EVP_CIPHER_CTX *cipher,
+                        EVP_MAC_CTX *mac,
+                        int enc
+                ) {
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(
+                ctx.get(),
+                +[](
+                        SSL *ssl,
+                        unsigned char *name,
+                        unsigned char *iv,
+                        EVP_CIPHER_CTX *cipher,
+                        HMAC_CTX *mac,
+                        int enc
+                ) {
+#endif
+                    auto ring = (TicketKeyRing *) SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), TicketKeyRing::index());
+
+                    if (!ring)
+                        return -1;
+
+                    int result = 1;
+                    std::optional<TicketKey> key;
+
+                    if (enc) {
+                        key = ring->current();
+
+                        if (!key)
+                            return -1;
+
+                        memcpy(name, key->name.data(), key->name.size());
+
+                        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)
+                            return -1;
+
+                        if (!EVP_EncryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key->aesKey.data(), iv))
+                            return -1;
+                    } else {
+                        std::optional<std::pair<TicketKey, bool>> found = ring->find(name);
+
+                        if (!found)
+                            return 0;
+
+                        key = found->first;
+                        result = found->second ? 2 : 1;
+
+                        if (!EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key->aesKey.data(), iv))
+                            return -1;
+                    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+                    OSSL_PARAM params[] = {
+                            OSSL_PARAM_construct_octet_string(
+                                    OSSL_MAC_PARAM_KEY,
+                                    key->hmacKey.data(),
+                                    key->hmacKey.size()
+                            ),
+                            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char *) "sha256", 0),
+                            OSSL_PARAM_construct_end()
+                    };
+
+                    if (!EVP_MAC_CTX_set_params(mac, params))
+                        return -1;
+#else
+                    if (!HMAC_Init_ex(mac, key->hmacKey.data(), (int) key->hmacKey.size(), EVP_sha256(), nullptr))
+                        return -1;
+#endif
+                    return result;
+                }
+        );
+    }
+
+    return ctx;
+}
+
+std::string aio::net::ssl::Registry::key(const Config &config) {
+    std::string key;
+
+    auto append = [&](const std::variant<std::monostate, std::string, std::filesystem::path> &value) {
+        key += std::to_string(value.index());
+        key += ':';
+
+        switch (value.index()) {
+            case 1:
+                key += std::get<1>(value);
+                break;
+
+            case 2:
+                key += std::get<2>(value).string();
+                break;
+
+            default:
+                break;
+        }
+
+        key += '|';
+    };
+
+    key += std::to_string(config.minVersion.value_or((Version) 0)) + '|';
+    key += std::to_string(config.maxVersion.value_or((Version) 0)) + '|';
+
+    append(config.ca);
+    append(config.cert);
+    append(config.privateKey);
+
+    key += std::to_string(config.insecure) + '|';
+    key += std::to_string(config.server) + '|';
+    key += std::to_string(config.sessionCacheSize) + '|';
+    key += std::to_string(config.ticketKeyRotation ? config.ticketKeyRotation->count() : 0) + '|';
+    key += std::to_string(config.ktls) + '|';
+
+    for (const auto &protocol: config.alpn) {
+        key += std::to_string(protocol.size()) + ':';
+        key += protocol;
+    }
+
+    return key;
+}
+
+std::shared_ptr<aio::net::ssl::Context> aio::net::ssl::Registry::get(const Config &config) {
+    std::string k = key(config);
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto it = mContexts.find(k);
+
+        if (it != mContexts.end())
+            return it->second.ctx;
+    }
+
+    std::shared_ptr<Context> ctx = newContext(config);
+
+    if (!ctx)
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mContexts.try_emplace(k, Entry{config, ctx}).first->second.ctx;
+}
+
+bool aio::net::ssl::Registry::bind(const std::string &serverName, const Config &config) {
+    if (!config.server)
+        return false;
+
+    if (!get(config))
+        return false;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    mServerNames[serverName] = key(config);
+
+    return true;
+}
+
+std::shared_ptr<aio::net::ssl::Context> aio::net::ssl::Registry::select(const std::string &serverName) {
+    std::lock_guard<std::mutex> guard(mMutex);
+    auto it = mServerNames.find(serverName);
+
+    if (it == mServerNames.end()) {
+        size_t pos = serverName.find('.');
+
+        if (pos != std::string::npos)
+            it = mServerNames.find("*" + serverName.substr(pos));
+
+        if (it == mServerNames.end())
+            it = mServerNames.find("");
+
+        if (it == mServerNames.end())
+            return nullptr;
+    }
+
+    auto entry = mContexts.find(it->second);
+
+    if (entry == mContexts.end())
+        return nullptr;
+
+    return entry->second.ctx;
+}
+
+std::shared_ptr<aio::net::ssl::Context> aio::net::ssl::Registry::server() {
+    std::optional<Config> config;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto it = mServerNames.find("");
+
+        if (it == mServerNames.end())
+            return nullptr;
+
+        config = mContexts.at(it->second).config;
+    }
+
+    std::shared_ptr<Context> ctx = newContext(*config);
+
+    if (!ctx)
+        return nullptr;
+
+    auto registry = new std::weak_ptr<Registry>(weak_from_this());
+
+    if (!SSL_CTX_set_ex_data(ctx.get(), index(), registry)) {
+        delete registry;
+        return nullptr;
+    }
+
+    SSL_CTX_set_tlsext_servername_callback(
+            ctx.get(),
+            +[](SSL *ssl, int *, void *) {
+                auto weak = (std::weak_ptr<Registry> *) SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), index());
+
+                if (!weak)
+                    return SSL_TLSEXT_ERR_OK;
+
+                std::shared_ptr<Registry> registry = weak->lock();
+
+                if (!registry)
+                    return SSL_TLSEXT_ERR_OK;
+
+                const char *host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+                std::shared_ptr<Context> selected = registry->select(host ? host : "");
+
+                if (!selected)
+                    return SSL_TLSEXT_ERR_ALERT_FATAL;
+
+                if (!SSL_set_SSL_CTX(ssl, selected.get()))
+                    return SSL_TLSEXT_ERR_ALERT_FATAL;
+
+                return SSL_TLSEXT_ERR_OK;
+            }
+    );
+
     return ctx;
 }
 
+int aio::net::ssl::Registry::index() {
+    static int index = SSL_CTX_get_ex_new_index(
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            [](void *parent, void *ptr, CRYPTO_EX_DATA *ad, int idx, long argl, void *argp) {
+                delete (std::weak_ptr<Registry> *) ptr;
+            }
+    );
+
+    return index;
+}
+
+bool aio::net::ssl::Registry::reload() {
+    std::map<std::string, Entry> contexts;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        contexts = mContexts;
+    }
+
+    for (auto &[k, entry]: contexts) {
+        std::shared_ptr<Context> ctx = newContext(entry.config);
+
+        if (!ctx)
+            return false;
+
+        entry.ctx = ctx;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    for (auto &[k, entry]: contexts)
+        mContexts[k] = std::move(entry);
+
+    return true;
+}
+
+void aio::net::ssl::Registry::clear() {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    mContexts.clear();
+    mServerNames.clear();
+}
+
+std::shared_ptr<aio::net::ssl::Registry> aio::net::ssl::defaultRegistry() {
+    static std::shared_ptr<Registry> registry = std::make_shared<Registry>();
+    return registry;
+}
+
 aio::net::ssl::stream::Buffer::Buffer(bufferevent *bev) : net::stream::Buffer(bev) {
 
 }
@@ -242,6 +816,158 @@ nonstd::expected<void, aio::Error> aio::net::ssl::stream::Buffer::close() {
     return net::stream::Buffer::close();
 }
 
+bool aio::net::ssl::stream::Buffer::alive() {
+    if (!mBev || mClosed)
+        return false;
+
+    SSL *ssl = bufferevent_openssl_get_ssl(mBev);
+
+    if (!ssl)
+        return false;
+
+    ERR_clear_error();
+
+    char c;
+    int n = SSL_peek(ssl, &c, 1);
+
+    if (n > 0)
+        return false;
+
+    return SSL_get_error(ssl, n) == SSL_ERROR_WANT_READ;
+}
+
+std::optional<std::string> aio::net::ssl::stream::Buffer::negotiatedProtocol() {
+    if (!mBev)
+        return std::nullopt;
+
+    SSL *ssl = bufferevent_openssl_get_ssl(mBev);
+
+    if (!ssl)
+        return std::nullopt;
+
+    const unsigned char *protocol = nullptr;
+    unsigned int length = 0;
+
+    SSL_get0_alpn_selected(ssl, &protocol, &length);
+
+    if (!protocol || !length)
+        return std::nullopt;
+
+    return std::string{(const char *) protocol, length};
+}
+
+bool aio::net::ssl::stream::Buffer::ktlsSend() {
+#ifdef AIO_KTLS
+    if (!mBev)
+        return false;
+
+    SSL *ssl = bufferevent_openssl_get_ssl(mBev);
+
+    if (!ssl)
+        return false;
+
+    return BIO_get_ktls_send(SSL_get_wbio(ssl));
+#else
+    return false;
+#endif
+}
+
+bool aio::net::ssl::stream::Buffer::ktlsReceive() {
+#ifdef AIO_KTLS
+    if (!mBev)
+        return false;
+
+    SSL *ssl = bufferevent_openssl_get_ssl(mBev);
+
+    if (!ssl)
+        return false;
+
+    return BIO_get_ktls_recv(SSL_get_rbio(ssl));
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<zero::async::promise::Promise<void>>
+aio::net::ssl::stream::Buffer::sendFile(int fd, off_t offset, size_t size) {
+#ifdef AIO_KTLS
+    if (!mBev)
+        return zero::async::promise::reject<void>({IO_BAD_RESOURCE, "send file on destroyed buffer"});
+
+    if (mClosed)
+        return zero::async::promise::reject<void>({IO_EOF, "send file on closed buffer"});
+
+    if (!ktlsSend())
+        return zero::async::promise::reject<void>({IO_NOT_SUPPORTED, "kernel TLS send not enabled"});
+
+    std::shared_ptr<size_t> sent = std::make_shared<size_t>(0);
+
+    addRef();
+
+    return drain()->then([=]() {
+        return zero::async::promise::loop<void>([=](const auto &loop) {
+            if (!mBev || mClosed) {
+                P_BREAK_E(loop, {IO_EOF, "buffer closed while sending file"});
+                return;
+            }
+
+            if (*sent == size) {
+                P_BREAK(loop);
+                return;
+            }
+
+            SSL *ssl = bufferevent_openssl_get_ssl(mBev);
+
+            ERR_clear_error();
+            ossl_ssize_t n = SSL_sendfile(ssl, fd, offset + (off_t) *sent, size - *sent, 0);
+
+            if (n > 0) {
+                *sent += n;
+                P_CONTINUE(loop);
+                return;
+            }
+
+            if (SSL_get_error(ssl, (int) n) != SSL_ERROR_WANT_WRITE) {
+                P_BREAK_E(
+                        loop,
+                        {IO_ERROR, zero::strings::format("send file failed[%s]", ssl::getError().c_str())}
+                );
+                return;
+            }
+
+            zero::async::promise::chain<void>([=](const auto &p) {
+                auto ctx = new std::shared_ptr<zero::async::promise::Promise<void>>(p);
+
+                if (event_base_once(
+                        bufferevent_get_base(mBev),
+                        bufferevent_getfd(mBev),
+                        EV_WRITE,
+                        [](evutil_socket_t, short, void *arg) {
+                            auto p = (std::shared_ptr<zero::async::promise::Promise<void>> *) arg;
+
+                            (*p)->resolve();
+                            delete p;
+                        },
+                        ctx,
+                        nullptr
+                ) < 0) {
+                    delete ctx;
+                    p->reject({IO_ERROR, "add write event failed"});
+                }
+            })->then([=]() {
+                P_CONTINUE(loop);
+            }, [=](const zero::async::promise::Reason &reason) {
+                P_BREAK_E(loop, reason);
+            });
+        });
+    })->finally([=]() {
+        release();
+    });
+#else
+    return zero::async::promise::reject<void>({IO_NOT_SUPPORTED, "kernel TLS not supported"});
+#endif
+}
+
 std::string aio::net::ssl::stream::Buffer::getError() {
     std::list<std::string> errors;
 
@@ -264,32 +990,216 @@ std::string aio::net::ssl::stream::Buffer::getError() {
 aio::net::ssl::stream::Listener::Listener(
         std::shared_ptr<aio::Context> context, std::shared_ptr<Context> ctx,
         evconnlistener *listener
-) : mCTX(std::move(ctx)), ListenerBase(std::move(context), listener) {
+) : mCTX(std::move(ctx)), ListenerBase(std::move(context), listener), mDispatching(false), mOffloads(0),
+    mConcurrency(HANDSHAKE_CONCURRENCY),
+    mBacklog(zero::ptr::makeRef<Channel<zero::ptr::RefPtr<net::stream::IBuffer>, 128>>(mContext)) {
 
 }
 
 std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
 aio::net::ssl::stream::Listener::accept() {
-    return fd()->then([=](evutil_socket_t fd) -> zero::ptr::RefPtr<net::stream::IBuffer> {
-        return zero::ptr::makeRef<Buffer>(
-                bufferevent_openssl_socket_new(
-                        mContext->base(),
-                        fd,
-                        SSL_new(mCTX.get()),
-                        BUFFEREVENT_SSL_ACCEPTING,
-                        BEV_OPT_CLOSE_ON_FREE
+    if (!mHandshakeTimeout && !mDispatching)
+        return fd()->then([=](evutil_socket_t fd) -> zero::ptr::RefPtr<net::stream::IBuffer> {
+            return zero::ptr::makeRef<Buffer>(
+                    bufferevent_openssl_socket_new(
+                            mContext->base(),
+                            fd,
+                            SSL_new(mCTX.get()),
+                            BUFFEREVENT_SSL_ACCEPTING,
+                            BEV_OPT_CLOSE_ON_FREE
+                    )
+            );
+        });
+
+    if (!mDispatching)
+        dispatch();
+
+    return zero::async::promise::chain<zero::ptr::RefPtr<net::stream::IBuffer>>([=](const auto &p) {
+        mBacklog->receive()->then([=](const zero::ptr::RefPtr<net::stream::IBuffer> &buffer) {
+            p->resolve(buffer);
+        }, [=](const zero::async::promise::Reason &reason) {
+            if (reason.code == IO_EOF && mError) {
+                p->reject(*mError);
+                return;
+            }
+
+            p->reject(reason);
+        });
+    });
+}
+
+void aio::net::ssl::stream::Listener::close() {
+    ListenerBase::close();
+    mBacklog->close();
+
+    std::queue<std::shared_ptr<zero::async::promise::Promise<void>>> slots = std::move(mSlots);
+
+    while (!slots.empty()) {
+        slots.front()->reject({IO_EOF, "listener is being closed"});
+        slots.pop();
+    }
+}
+
+void aio::net::ssl::stream::Listener::setHandshakeOffload(
+        std::optional<std::chrono::milliseconds> timeout,
+        size_t concurrency
+) {
+    mHandshakeTimeout = timeout;
+    mConcurrency = (std::max)(concurrency, size_t{1});
+}
+
+void aio::net::ssl::stream::Listener::dispatch() {
+    std::chrono::milliseconds timeout = *mHandshakeTimeout;
+
+    mDispatching = true;
+    addRef();
+
+    zero::async::promise::loop<void>([=](const auto &loop) {
+        fd()->then([=](evutil_socket_t fd) {
+            handshake(fd, timeout);
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            P_BREAK_E(loop, reason);
+        });
+    })->fail([=](const zero::async::promise::Reason &reason) {
+        if (reason.code != IO_EOF && reason.code != IO_BAD_RESOURCE)
+            mError = reason;
+
+        mBacklog->close();
+    })->finally([=]() {
+        release();
+    });
+}
+
+void aio::net::ssl::stream::Listener::handshake(evutil_socket_t fd, std::chrono::milliseconds timeout) {
+    SSL *ssl = SSL_new(mCTX.get());
+
+    if (!ssl) {
+        evutil_closesocket(fd);
+        return;
+    }
+
+    if (!SSL_set_fd(ssl, (int) fd)) {
+        SSL_free(ssl);
+        evutil_closesocket(fd);
+        return;
+    }
+
+    std::shared_ptr<aio::Context> context = mContext;
+    std::shared_ptr<short> events = std::make_shared<short>(ev::READ);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    zero::ptr::RefPtr<ev::Event> event = zero::ptr::makeRef<ev::Event>(context, fd);
+
+    addRef();
+
+    // wait for the peer on the event loop, run only the SSL_accept steps that have data to process on a worker.
+    zero::async::promise::loop<void>([=](const auto &loop) {
+        auto remain = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()
+        );
+
+        if (remain.count() <= 0) {
+            P_BREAK_E(loop, { IO_TIMEOUT, "SSL handshake timed out" });
+            return;
+        }
+
+        event->on(*events, remain)->then([=](short what) -> std::shared_ptr<zero::async::promise::Promise<short>> {
+            if (what & ev::TIMEOUT)
+                return zero::async::promise::reject<short>({IO_TIMEOUT, "SSL handshake timed out"});
+
+            return acquireSlot()->then([=]() {
+                return toThread<short>(
+                        context,
+                        [=]() -> nonstd::expected<short, zero::async::promise::Reason> {
+                            ERR_clear_error();
+                            int n = SSL_accept(ssl);
+
+                            if (n == 1)
+                                return 0;
+
+                            int e = SSL_get_error(ssl, n);
+
+                            if (e == SSL_ERROR_WANT_READ)
+                                return ev::READ;
+
+                            if (e == SSL_ERROR_WANT_WRITE)
+                                return ev::WRITE;
+
+                            return nonstd::make_unexpected(
+                                    zero::async::promise::Reason{
+                                            IO_ERROR,
+                                            zero::strings::format("SSL handshake failed[%s]", getError().c_str())
+                                    }
+                            );
+                        }
+                )->finally([=]() {
+                    releaseSlot();
+                });
+            });
+        })->then([=](short next) {
+            if (!next) {
+                P_BREAK(loop);
+                return;
+            }
+
+            *events = next;
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            P_BREAK_E(loop, reason);
+        });
+    })->then([=]() {
+        mBacklog->send(
+                zero::ptr::makeRef<Buffer>(
+                        bufferevent_openssl_socket_new(
+                                context->base(),
+                                -1,
+                                ssl,
+                                BUFFEREVENT_SSL_OPEN,
+                                BEV_OPT_CLOSE_ON_FREE
+                        )
                 )
         );
+    }, [=](const zero::async::promise::Reason &reason) {
+        SSL_free(ssl);
+        evutil_closesocket(fd);
+    })->finally([=]() {
+        release();
     });
 }
 
+std::shared_ptr<zero::async::promise::Promise<void>> aio::net::ssl::stream::Listener::acquireSlot() {
+    if (!mListener)
+        return zero::async::promise::reject<void>({IO_EOF, "listener is being closed"});
+
+    if (mOffloads < mConcurrency) {
+        mOffloads++;
+        return zero::async::promise::resolve<void>();
+    }
+
+    return zero::async::promise::chain<void>([=](const auto &p) {
+        mSlots.push(p);
+    });
+}
+
+void aio::net::ssl::stream::Listener::releaseSlot() {
+    if (mSlots.empty()) {
+        mOffloads--;
+        return;
+    }
+
+    auto slot = std::move(mSlots.front());
+    mSlots.pop();
+
+    slot->resolve();
+}
+
 zero::ptr::RefPtr<aio::net::ssl::stream::Listener>
 aio::net::ssl::stream::listen(
         const std::shared_ptr<aio::Context> &context,
         const aio::net::Address &address,
         const std::shared_ptr<Context> &ctx
 ) {
-    std::optional<std::vector<std::byte>> socketAddress = socketAddressFrom(address);
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
 
     if (!socketAddress)
         return nullptr;
@@ -300,8 +1210,8 @@ aio::net::ssl::stream::listen(
             nullptr,
             LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE | LEV_OPT_DISABLED,
             -1,
-            (const sockaddr *) socketAddress->data(),
-            (int) socketAddress->size()
+            (const sockaddr *) &socketAddress->storage,
+            (int) socketAddress->length
     );
 
     if (!listener)
@@ -347,16 +1257,17 @@ std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream
 aio::net::ssl::stream::connect(
         const std::shared_ptr<aio::Context> &context,
         const std::string &host,
-        unsigned short port
+        unsigned short port,
+        std::chrono::milliseconds delay
 ) {
-    static std::shared_ptr<Context> ctx = newContext({});
+    std::shared_ptr<Context> ctx = defaultRegistry()->get({});
 
     if (!ctx)
         return zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
                 {SSL_INIT_ERROR, zero::strings::format("create default SSL context failed[%s]", getError().c_str())}
         );
 
-    return connect(context, host, port, ctx);
+    return connect(context, host, port, ctx, delay);
 }
 
 std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
@@ -371,10 +1282,15 @@ aio::net::ssl::stream::connect(const std::shared_ptr<aio::Context> &context, con
 }
 
 std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
-aio::net::ssl::stream::connect(const std::shared_ptr<aio::Context> &context, nonstd::span<const Address> addresses) {
-    return tryAddress<zero::ptr::RefPtr<net::stream::IBuffer>>(
+aio::net::ssl::stream::connect(
+        const std::shared_ptr<aio::Context> &context,
+        nonstd::span<const Address> addresses,
+        std::chrono::milliseconds delay
+) {
+    return raceAddress<zero::ptr::RefPtr<net::stream::IBuffer>>(
             context,
             addresses,
+            delay,
             [](const std::shared_ptr<aio::Context> &context, const Address &address) {
                 return connect(context, address);
             }
@@ -386,23 +1302,90 @@ aio::net::ssl::stream::connect(
         const std::shared_ptr<aio::Context> &context,
         const std::string &host,
         unsigned short port,
+        const std::shared_ptr<Context> &ctx,
+        std::chrono::milliseconds delay
+) {
+    evutil_addrinfo hints = {};
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    return dns::getAddressInfo(
+            context,
+            host,
+            std::to_string(port),
+            hints
+    )->then([=](nonstd::span<const Address> addresses) {
+        return raceAddress<zero::ptr::RefPtr<net::stream::IBuffer>>(
+                context,
+                addresses,
+                delay,
+                [=](const std::shared_ptr<aio::Context> &context, const Address &address) {
+                    return attempt(context, address, host, ctx);
+                }
+        );
+    });
+}
+
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
+aio::net::ssl::stream::connect(
+        const std::shared_ptr<aio::Context> &context,
+        const Address &address,
+        const std::string &host,
         const std::shared_ptr<Context> &ctx
 ) {
+    return attempt(context, address, host, ctx).promise;
+}
+
+aio::net::Attempt<zero::ptr::RefPtr<aio::net::stream::IBuffer>>
+aio::net::ssl::stream::attempt(
+        const std::shared_ptr<aio::Context> &context,
+        const Address &address,
+        const std::string &host,
+        const std::shared_ptr<Context> &ctx
+) {
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
+
+    if (!socketAddress)
+        return {
+                zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
+                        {INVALID_ARGUMENT, "invalid address"}
+                )
+        };
+
     SSL *ssl = SSL_new(ctx.get());
 
     if (!ssl)
-        return zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
-                {SSL_INIT_ERROR, zero::strings::format("create SSL structure failed[%s]", getError().c_str())}
-        );
+        return {
+                zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
+                        {SSL_INIT_ERROR, zero::strings::format("create SSL structure failed[%s]", getError().c_str())}
+                )
+        };
 
     SSL_set_tlsext_host_name(ssl, host.c_str());
     SSL_set_hostflags(ssl, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
 
+    auto cache = (SessionCache *) SSL_CTX_get_ex_data(ctx.get(), SessionCache::index());
+
+    if (cache) {
+        SSL_SESSION *session = cache->get(host);
+
+        if (session) {
+            SSL_set_session(ssl, session);
+            SSL_SESSION_free(session);
+        }
+    }
+
     if (!SSL_set1_host(ssl, host.c_str())) {
         SSL_free(ssl);
-        return zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
-                {SSL_INIT_ERROR, zero::strings::format("set SSL expected hostname failed[%s]", getError().c_str())}
-        );
+        return {
+                zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
+                        {
+                                SSL_INIT_ERROR,
+                                zero::strings::format("set SSL expected hostname failed[%s]", getError().c_str())
+                        }
+                )
+        };
     }
 
     bufferevent *bev = bufferevent_openssl_socket_new(
@@ -414,11 +1397,16 @@ aio::net::ssl::stream::connect(
     );
 
     if (!bev)
-        return zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
-                {SSL_INIT_ERROR, zero::strings::format("create SSL stream buffer failed[%s]", lastError().c_str())}
-        );
+        return {
+                zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(
+                        {
+                                SSL_INIT_ERROR,
+                                zero::strings::format("create SSL stream buffer failed[%s]", lastError().c_str())
+                        }
+                )
+        };
 
-    return zero::async::promise::chain<void>([=](const auto &p) {
+    auto promise = zero::async::promise::chain<void>([=](const auto &p) {
         auto ctx = new std::shared_ptr(p);
 
         bufferevent_setcb(
@@ -461,7 +1449,11 @@ aio::net::ssl::stream::connect(
                 ctx
         );
 
-        if (bufferevent_socket_connect_hostname(bev, context->dnsBase(), AF_UNSPEC, host.c_str(), port) < 0) {
+        if (bufferevent_socket_connect(
+                bev,
+                (const sockaddr *) &socketAddress->storage,
+                (int) socketAddress->length
+        ) < 0) {
             delete ctx;
             p->reject({IO_ERROR, zero::strings::format("buffer connect to remote failed[%s]", lastError().c_str())});
         }
@@ -471,6 +1463,13 @@ aio::net::ssl::stream::connect(
         bufferevent_free(bev);
         return zero::async::promise::reject<zero::ptr::RefPtr<net::stream::IBuffer>>(reason);
     });
+
+    return {
+            promise,
+            [=]() {
+                bufferevent_trigger_event(bev, BEV_EVENT_ERROR, 0);
+            }
+    };
 }
 
 std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
@@ -479,30 +1478,32 @@ aio::net::ssl::stream::connect(
         const Address &address,
         const std::shared_ptr<Context> &ctx
 ) {
-    if (address.index() == 0) {
-        IPv4Address ipv4Address = std::get<IPv4Address>(address);
-        return connect(context, zero::os::net::stringify(ipv4Address.ip), ipv4Address.port, ctx);
-    }
+    if (address.index() == 0)
+        return connect(context, address, zero::os::net::stringify(std::get<IPv4Address>(address).ip), ctx);
 
-    IPv6Address ipv6Address = std::get<IPv6Address>(address);
-    return connect(context, zero::os::net::stringify(ipv6Address.ip), ipv6Address.port, ctx);
+    return connect(context, address, zero::os::net::stringify(std::get<IPv6Address>(address).ip), ctx);
 }
 
 std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
 aio::net::ssl::stream::connect(
         const std::shared_ptr<aio::Context> &context,
         nonstd::span<const Address> addresses,
-        const std::shared_ptr<Context> &ctx
+        const std::shared_ptr<Context> &ctx,
+        std::chrono::milliseconds delay
 ) {
-    return tryAddress<zero::ptr::RefPtr<net::stream::IBuffer>>(
+    return raceAddress<zero::ptr::RefPtr<net::stream::IBuffer>>(
             context,
             addresses,
+            delay,
             [](
                     const std::shared_ptr<aio::Context> &context,
                     const Address &address,
                     const std::shared_ptr<Context> &ctx
             ) {
-                return connect(context, address, ctx);
+                if (address.index() == 0)
+                    return attempt(context, address, zero::os::net::stringify(std::get<IPv4Address>(address).ip), ctx);
+
+                return attempt(context, address, zero::os::net::stringify(std::get<IPv6Address>(address).ip), ctx);
             },
             ctx
     );
@@ -1,10 +1,15 @@
 #include <aio/net/stream.h>
-#include <zero/os/net.h>
+#include <aio/net/dns.h>
 #include <zero/strings/strings.h>
 #include <cstring>
 
 #ifdef __linux__
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#ifndef TCP_FASTOPEN_CONNECT
+#define TCP_FASTOPEN_CONNECT 30
+#endif
 #endif
 
 #ifdef __unix__
@@ -33,13 +38,33 @@ std::optional<aio::net::Address> aio::net::stream::Buffer::remoteAddress() {
     return getSocketAddress(fd, true);
 }
 
-aio::net::stream::ListenerBase::ListenerBase(std::shared_ptr<Context> context, evconnlistener *listener)
-        : mContext(std::move(context)), mListener(listener) {
+nonstd::expected<void, aio::Error> aio::net::stream::Buffer::setOptions(const SocketOptions &options) {
+    evutil_socket_t fd = this->fd();
+
+    if (fd == -1)
+        return nonstd::make_unexpected(IO_BAD_RESOURCE);
+
+    return setSocketOptions(fd, options);
+}
+
+aio::net::stream::ListenerBase::ListenerBase(
+        std::shared_ptr<Context> context,
+        evconnlistener *listener,
+        std::optional<SocketOptions> options
+) : mContext(std::move(context)), mListener(listener), mOptions(std::move(options)) {
+    if (mOptions)
+        mOptions->fastOpen.reset();
+
     evconnlistener_set_cb(
             mListener,
             [](evconnlistener *listener, evutil_socket_t fd, sockaddr *addr, int socklen, void *arg) {
                 zero::ptr::RefPtr<ListenerBase> ptr((ListenerBase *) arg);
 
+                if (ptr->mOptions && !setSocketOptions(fd, *ptr->mOptions)) {
+                    evutil_closesocket(fd);
+                    return;
+                }
+
                 auto p = std::move(ptr->mPromise);
                 p->resolve(fd);
             },
@@ -96,8 +121,26 @@ void aio::net::stream::ListenerBase::close() {
     mListener = nullptr;
 }
 
-aio::net::stream::Listener::Listener(std::shared_ptr<Context> context, evconnlistener *listener)
-        : ListenerBase(std::move(context), listener) {
+nonstd::expected<void, aio::Error> aio::net::stream::ListenerBase::setOptions(const SocketOptions &options) {
+    if (!mListener)
+        return nonstd::make_unexpected(IO_BAD_RESOURCE);
+
+    nonstd::expected<void, Error> result = setSocketOptions(evconnlistener_get_fd(mListener), options);
+
+    if (!result)
+        return result;
+
+    mOptions = options;
+    mOptions->fastOpen.reset();
+
+    return {};
+}
+
+aio::net::stream::Listener::Listener(
+        std::shared_ptr<Context> context,
+        evconnlistener *listener,
+        std::optional<SocketOptions> options
+) : ListenerBase(std::move(context), listener, std::move(options)) {
 
 }
 
@@ -109,25 +152,47 @@ std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream
 
 zero::ptr::RefPtr<aio::net::stream::Listener>
 aio::net::stream::listen(const std::shared_ptr<Context> &context, const Address &address) {
-    std::optional<std::vector<std::byte>> socketAddress = socketAddressFrom(address);
+    return listen(context, address, SocketOptions{});
+}
+
+zero::ptr::RefPtr<aio::net::stream::Listener>
+aio::net::stream::listen(
+        const std::shared_ptr<Context> &context,
+        const Address &address,
+        const SocketOptions &options
+) {
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
 
     if (!socketAddress)
         return nullptr;
 
-    evconnlistener *listener = evconnlistener_new_bind(
+    evutil_socket_t fd = socket(socketAddress->storage.ss_family, SOCK_STREAM, 0);
+
+    if (fd == EVUTIL_INVALID_SOCKET)
+        return nullptr;
+
+    if (evutil_make_socket_nonblocking(fd) != 0 || evutil_make_socket_closeonexec(fd) != 0 ||
+        evutil_make_listen_socket_reuseable(fd) != 0 || !setSocketOptions(fd, options) ||
+        bind(fd, (const sockaddr *) &socketAddress->storage, socketAddress->length) != 0) {
+        evutil_closesocket(fd);
+        return nullptr;
+    }
+
+    evconnlistener *listener = evconnlistener_new(
             context->base(),
             nullptr,
             nullptr,
-            LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE | LEV_OPT_DISABLED,
+            LEV_OPT_CLOSE_ON_FREE | LEV_OPT_DISABLED,
             -1,
-            (const sockaddr *) socketAddress->data(),
-            (int) socketAddress->size()
+            fd
     );
 
-    if (!listener)
+    if (!listener) {
+        evutil_closesocket(fd);
         return nullptr;
+    }
 
-    return zero::ptr::makeRef<Listener>(context, listener);
+    return zero::ptr::makeRef<Listener>(context, listener, options);
 }
 
 zero::ptr::RefPtr<aio::net::stream::Listener>
@@ -154,58 +219,113 @@ aio::net::stream::listen(const std::shared_ptr<Context> &context, const std::str
     return listen(context, *address);
 }
 
+zero::ptr::RefPtr<aio::net::stream::Listener> aio::net::stream::listen(
+        const std::shared_ptr<Context> &context,
+        const std::string &ip,
+        unsigned short port,
+        const SocketOptions &options
+) {
+    std::optional<Address> address = IPAddressFrom(ip, port);
+
+    if (!address)
+        return nullptr;
+
+    return listen(context, *address, options);
+}
+
 std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
 aio::net::stream::connect(const std::shared_ptr<Context> &context, const Address &address) {
-    std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<IBuffer>>> promise;
+    return connect(context, address, nonstd::span<const std::byte>{});
+}
 
-    switch (address.index()) {
-        case 0: {
-            IPv4Address ipv4Address = std::get<IPv4Address>(address);
-            promise = connect(context, zero::os::net::stringify(ipv4Address.ip), ipv4Address.port);
-            break;
-        }
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
+aio::net::stream::connect(
+        const std::shared_ptr<Context> &context,
+        const Address &address,
+        nonstd::span<const std::byte> data
+) {
+    if (address.index() == 2) {
+#ifdef __unix__
+        if (data.empty())
+            return connect(context, std::get<UnixAddress>(address).path);
 
-        case 1: {
-            IPv6Address ipv6Address = std::get<IPv6Address>(address);
-            promise = connect(context, zero::os::net::stringify(ipv6Address.ip), ipv6Address.port);
-            break;
-        }
+        return connect(context, std::get<UnixAddress>(address).path)->then(
+                [data = std::vector<std::byte>{data.begin(), data.end()}](const zero::ptr::RefPtr<IBuffer> &buffer) {
+                    nonstd::expected<void, Error> result = buffer->submit(data);
 
-        case 2: {
-#ifdef __unix__
-            promise = connect(context, std::get<UnixAddress>(address).path);
+                    if (!result)
+                        return zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
+                                {result.error(), "failed to submit data to buffer"}
+                        );
+
+                    return zero::async::promise::resolve<zero::ptr::RefPtr<IBuffer>>(buffer);
+                }
+        );
 #else
-            promise = zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
-                    {INVALID_ARGUMENT, "unsupported unix domain socket"}
-            );
+        return zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
+                {INVALID_ARGUMENT, "unsupported unix domain socket"}
+        );
 #endif
-        }
     }
 
-    return promise;
+    return attempt(context, address, data).promise;
 }
 
-std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
-aio::net::stream::connect(const std::shared_ptr<Context> &context, nonstd::span<const Address> addresses) {
-    return tryAddress<zero::ptr::RefPtr<IBuffer>>(
-            context,
-            addresses,
-            [](const std::shared_ptr<Context> &context, const Address &address) {
-                return connect(context, address);
-            }
-    );
-}
+aio::net::Attempt<zero::ptr::RefPtr<aio::net::stream::IBuffer>>
+aio::net::stream::attempt(
+        const std::shared_ptr<Context> &context,
+        const Address &address,
+        nonstd::span<const std::byte> data
+) {
+    if (address.index() == 2)
+        return {connect(context, address, data)};
 
-std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
-aio::net::stream::connect(const std::shared_ptr<Context> &context, const std::string &host, unsigned short port) {
-    bufferevent *bev = bufferevent_socket_new(context->base(), -1, BEV_OPT_CLOSE_ON_FREE);
+    std::optional<SocketAddress> socketAddress = socketAddressFrom(address);
 
-    if (!bev)
-        return zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
-                {IO_ERROR, zero::strings::format("create buffer failed[%s]", lastError().c_str())}
-        );
+    if (!socketAddress)
+        return {zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>({INVALID_ARGUMENT, "invalid address"})};
+
+    evutil_socket_t fd = -1;
+
+    if (!data.empty()) {
+        fd = socket(socketAddress->storage.ss_family, SOCK_STREAM, 0);
+
+        if (fd == EVUTIL_INVALID_SOCKET)
+            return {
+                    zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
+                            {IO_ERROR, zero::strings::format("create socket failed[%s]", lastError().c_str())}
+                    )
+            };
+
+        if (evutil_make_socket_nonblocking(fd) != 0 || evutil_make_socket_closeonexec(fd) != 0) {
+            evutil_closesocket(fd);
+            return {
+                    zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
+                            {IO_ERROR, zero::strings::format("set socket flags failed[%s]", lastError().c_str())}
+                    )
+            };
+        }
 
-    return zero::async::promise::chain<void>([=](const auto &p) {
+#ifdef __linux__
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &on, sizeof(on));
+#endif
+    }
+
+    bufferevent *bev = bufferevent_socket_new(context->base(), fd, BEV_OPT_CLOSE_ON_FREE);
+
+    if (!bev) {
+        if (fd != -1)
+            evutil_closesocket(fd);
+
+        return {
+                zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(
+                        {IO_ERROR, zero::strings::format("create buffer failed[%s]", lastError().c_str())}
+                )
+        };
+    }
+
+    auto promise = zero::async::promise::chain<void>([=](const auto &p) {
         auto ctx = new std::shared_ptr(p);
 
         bufferevent_setcb(
@@ -235,16 +355,69 @@ aio::net::stream::connect(const std::shared_ptr<Context> &context, const std::st
                 ctx
         );
 
-        if (bufferevent_socket_connect_hostname(bev, context->dnsBase(), AF_UNSPEC, host.c_str(), port) < 0) {
+        if (bufferevent_socket_connect(
+                bev,
+                (const sockaddr *) &socketAddress->storage,
+                (int) socketAddress->length
+        ) < 0) {
             delete ctx;
             p->reject({IO_ERROR, zero::strings::format("buffer connect to remote failed[%s]", lastError().c_str())});
+            return;
         }
+
+        if (!data.empty())
+            bufferevent_write(bev, data.data(), data.size());
     })->then([=]() -> zero::ptr::RefPtr<IBuffer> {
         return zero::ptr::makeRef<Buffer>(bev);
     })->fail([=](const zero::async::promise::Reason &reason) {
         bufferevent_free(bev);
         return zero::async::promise::reject<zero::ptr::RefPtr<IBuffer>>(reason);
     });
+
+    return {
+            promise,
+            [=]() {
+                bufferevent_trigger_event(bev, BEV_EVENT_ERROR, 0);
+            }
+    };
+}
+
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
+aio::net::stream::connect(
+        const std::shared_ptr<Context> &context,
+        nonstd::span<const Address> addresses,
+        std::chrono::milliseconds delay
+) {
+    return raceAddress<zero::ptr::RefPtr<IBuffer>>(
+            context,
+            addresses,
+            delay,
+            [](const std::shared_ptr<Context> &context, const Address &address) {
+                return attempt(context, address, {});
+            }
+    );
+}
+
+std::shared_ptr<zero::async::promise::Promise<zero::ptr::RefPtr<aio::net::stream::IBuffer>>>
+aio::net::stream::connect(
+        const std::shared_ptr<Context> &context,
+        const std::string &host,
+        unsigned short port,
+        std::chrono::milliseconds delay
+) {
+    evutil_addrinfo hints = {};
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    return dns::getAddressInfo(
+            context,
+            host,
+            std::to_string(port),
+            hints
+    )->then([=](nonstd::span<const Address> addresses) {
+        return connect(context, addresses, delay);
+    });
 }
 
 #ifdef __unix__
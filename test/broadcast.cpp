@@ -0,0 +1,165 @@
+#include <aio/broadcast.h>
+#include <aio/thread.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("async broadcast channel", "[broadcast]") {
+    std::shared_ptr<aio::Context> context = aio::newContext();
+    REQUIRE(context);
+
+    SECTION("block sender") {
+        std::shared_ptr<int> counters[3] = {std::make_shared<int>(), std::make_shared<int>(), std::make_shared<int>()};
+        zero::ptr::RefPtr<aio::Broadcast<int, 100>> broadcast = zero::ptr::makeRef<aio::Broadcast<int, 100>>(context);
+
+        zero::ptr::RefPtr<aio::Subscriber<int, 100>> subscribers[2] = {
+                broadcast->subscribe(),
+                broadcast->subscribe()
+        };
+
+        zero::async::promise::loop<void>([=](const auto &loop) {
+            if (*counters[0] >= 10000) {
+                P_BREAK(loop);
+                return;
+            }
+
+            broadcast->send((*counters[0])++)->then(
+                    PF_LOOP_CONTINUE(loop),
+                    PF_LOOP_THROW(loop)
+            );
+        })->then([=]() {
+            broadcast->close();
+        }, [](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        });
+
+        zero::async::promise::all(
+                zero::async::promise::doWhile([=]() {
+                    return subscribers[0]->receive()->then([=](const std::shared_ptr<const int> &element) {
+                        REQUIRE(*element == (*counters[1])++);
+                    });
+                })->fail([=](const zero::async::promise::Reason &reason) {
+                    REQUIRE(reason.code == aio::IO_EOF);
+                }),
+                zero::async::promise::doWhile([=]() {
+                    return subscribers[1]->receive()->then([=](const std::shared_ptr<const int> &element) {
+                        REQUIRE(*element == (*counters[2])++);
+                    });
+                })->fail([=](const zero::async::promise::Reason &reason) {
+                    REQUIRE(reason.code == aio::IO_EOF);
+                })
+        )->then([=]() {
+            REQUIRE(*counters[1] == 10000);
+            REQUIRE(*counters[2] == 10000);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("shared element") {
+        zero::ptr::RefPtr<aio::Broadcast<int, 10>> broadcast = zero::ptr::makeRef<aio::Broadcast<int, 10>>(context);
+
+        zero::ptr::RefPtr<aio::Subscriber<int, 10>> subscribers[2] = {
+                broadcast->subscribe(),
+                broadcast->subscribe()
+        };
+
+        REQUIRE(broadcast->trySend(1024));
+
+        nonstd::expected<std::shared_ptr<const int>, aio::Error> elements[2] = {
+                subscribers[0]->tryReceive(),
+                subscribers[1]->tryReceive()
+        };
+
+        REQUIRE(elements[0]);
+        REQUIRE(elements[1]);
+        REQUIRE(**elements[0] == 1024);
+        REQUIRE(elements[0]->get() == elements[1]->get());
+        REQUIRE(subscribers[0]->tryReceive().error() == aio::IO_WOULD_BLOCK);
+    }
+
+    SECTION("drop oldest") {
+        zero::ptr::RefPtr<aio::Broadcast<int, 10>> broadcast = zero::ptr::makeRef<aio::Broadcast<int, 10>>(
+                context,
+                aio::DROP_OLDEST
+        );
+
+        zero::ptr::RefPtr<aio::Subscriber<int, 10>> subscriber = broadcast->subscribe();
+
+        for (int i = 0; i < 15; i++)
+            REQUIRE(broadcast->trySend(i));
+
+        REQUIRE(subscriber->dropped() == 5);
+
+        nonstd::expected<std::shared_ptr<const int>, aio::Error> element = subscriber->tryReceive();
+
+        REQUIRE(element);
+        REQUIRE(**element == 5);
+    }
+
+    SECTION("disconnect subscriber") {
+        zero::ptr::RefPtr<aio::Broadcast<int, 10>> broadcast = zero::ptr::makeRef<aio::Broadcast<int, 10>>(
+                context,
+                aio::DISCONNECT_SUBSCRIBER
+        );
+
+        zero::ptr::RefPtr<aio::Subscriber<int, 10>> subscribers[2] = {
+                broadcast->subscribe(),
+                broadcast->subscribe()
+        };
+
+        for (int i = 0; i < 10; i++) {
+            REQUIRE(broadcast->trySend(i));
+            REQUIRE(subscribers[1]->tryReceive());
+        }
+
+        REQUIRE(broadcast->trySend(10));
+        REQUIRE(subscribers[0]->tryReceive().error() == aio::IO_LAGGED);
+        REQUIRE(subscribers[1]->tryReceive());
+    }
+
+    SECTION("sync sender/async receiver") {
+        std::shared_ptr<int> counter = std::make_shared<int>();
+        zero::ptr::RefPtr<aio::Broadcast<int, 100>> broadcast = zero::ptr::makeRef<aio::Broadcast<int, 100>>(context);
+        zero::ptr::RefPtr<aio::Subscriber<int, 100>> subscriber = broadcast->subscribe();
+
+        aio::toThread<void>(context, [=]() {
+            for (int i = 0; i < 10000; i++) {
+                if (!broadcast->sendSync(i))
+                    FAIL();
+            }
+
+            broadcast->close();
+        });
+
+        zero::async::promise::doWhile([=]() {
+            return subscriber->receive()->then([=](const std::shared_ptr<const int> &element) {
+                REQUIRE(*element == (*counter)++);
+            });
+        })->fail([=](const zero::async::promise::Reason &reason) {
+            REQUIRE(reason.code == aio::IO_EOF);
+            REQUIRE(*counter == 10000);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("receive timeout") {
+        zero::ptr::RefPtr<aio::Broadcast<int, 10>> broadcast = zero::ptr::makeRef<aio::Broadcast<int, 10>>(context);
+        zero::ptr::RefPtr<aio::Subscriber<int, 10>> subscriber = broadcast->subscribe();
+
+        subscriber->receive(50ms)->then([=](const std::shared_ptr<const int> &element) {
+            FAIL();
+        }, [=](const zero::async::promise::Reason &reason) {
+            REQUIRE(reason.code == aio::IO_TIMEOUT);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+}
@@ -259,4 +259,41 @@ TEST_CASE("async channel buffer", "[channel]") {
             context->dispatch();
         }
     }
+
+    SECTION("metrics") {
+        zero::ptr::RefPtr<aio::Channel<int, 100>> metered = zero::ptr::makeRef<aio::Channel<int, 100>>(context, true);
+
+        REQUIRE(!zero::ptr::makeRef<aio::Channel<int, 100>>(context)->metrics());
+
+        for (int i = 0; i < 10; i++)
+            REQUIRE(metered->trySend(i));
+
+        REQUIRE(metered->tryReceive());
+
+        std::optional<aio::ChannelMetrics> metrics = metered->metrics();
+        REQUIRE(metrics);
+        REQUIRE(metrics->depth == 9);
+        REQUIRE(metrics->highWatermark == 10);
+        REQUIRE(metrics->sends == 10);
+        REQUIRE(metrics->receives == 1);
+
+        for (int i = 0; i < 9; i++)
+            REQUIRE(metered->tryReceive());
+
+        metered->receive(50ms)->then([=](int element) {
+            FAIL();
+        }, [=](const zero::async::promise::Reason &reason) {
+            REQUIRE(reason.code == aio::IO_TIMEOUT);
+
+            std::optional<aio::ChannelMetrics> metrics = metered->metrics();
+            REQUIRE(metrics);
+            REQUIRE(metrics->depth == 0);
+            REQUIRE(metrics->timeouts == 1);
+            REQUIRE(metrics->receiverWaited >= 50ms);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <aio/coroutine.h>
+#include <aio/channel.h>
+#include <aio/ev/pipe.h>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("coroutine awaitable", "[coroutine]") {
+    std::shared_ptr<aio::Context> context = aio::newContext();
+    REQUIRE(context);
+
+    SECTION("sleep") {
+        aio::coroutine::toPromise([](std::shared_ptr<aio::Context> context) -> aio::coroutine::Task<void> {
+            auto start = std::chrono::steady_clock::now();
+            aio::coroutine::Result<void> result = co_await aio::coroutine::sleep(context, 50ms);
+
+            REQUIRE(result);
+            REQUIRE(std::chrono::steady_clock::now() - start >= 50ms);
+
+            co_return {};
+        }(context))->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("channel") {
+        zero::ptr::RefPtr<aio::Channel<int, 10>> channel = zero::ptr::makeRef<aio::Channel<int, 10>>(context);
+
+        aio::coroutine::toPromise([](zero::ptr::RefPtr<aio::Channel<int, 10>> channel) -> aio::coroutine::Task<int> {
+            int sum = 0;
+
+            while (true) {
+                aio::coroutine::Result<int> element = co_await aio::coroutine::receive(channel);
+
+                if (!element) {
+                    REQUIRE(element.error().code == aio::IO_EOF);
+                    break;
+                }
+
+                sum += *element;
+            }
+
+            co_return sum;
+        }(channel))->then([](int sum) {
+            REQUIRE(sum == 4950);
+        }, [](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        aio::coroutine::toPromise([](zero::ptr::RefPtr<aio::Channel<int, 10>> channel) -> aio::coroutine::Task<void> {
+            for (int i = 0; i < 100; i++) {
+                aio::coroutine::Result<void> result = co_await channel->send(i);
+
+                if (!result)
+                    co_return nonstd::make_unexpected(result.error());
+            }
+
+            channel->close();
+            co_return {};
+        }(channel));
+
+        context->dispatch();
+    }
+
+    SECTION("buffer") {
+        std::array<zero::ptr::RefPtr<aio::ev::IPairedBuffer>, 2> buffers = aio::ev::pipe(context);
+
+        aio::coroutine::toPromise([](
+                std::array<zero::ptr::RefPtr<aio::ev::IPairedBuffer>, 2> buffers
+        ) -> aio::coroutine::Task<void> {
+            buffers[0]->writeLine("hello world");
+
+            aio::coroutine::Result<std::string> line = co_await buffers[1]->readLine();
+
+            REQUIRE(line);
+            REQUIRE(*line == "hello world");
+
+            buffers[0]->writeLine("world hello");
+            buffers[0]->writeLine("hello world");
+
+            line = co_await aio::coroutine::readLine(buffers[1]);
+
+            REQUIRE(line);
+            REQUIRE(*line == "world hello");
+
+            line = co_await aio::coroutine::readLine(buffers[1]);
+
+            REQUIRE(line);
+            REQUIRE(*line == "hello world");
+
+            co_return {};
+        }(buffers))->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+}
@@ -51,6 +51,41 @@ TEST_CASE("async stream buffer", "[buffer]") {
         context->dispatch();
     }
 
+    SECTION("try read") {
+        REQUIRE(buffers[1]->tryRead(1024).error() == aio::IO_WOULD_BLOCK);
+
+        buffers[0]->writeLine("hello world");
+        buffers[0]->writeLine("world hello");
+
+        buffers[0]->drain()->then([=]() {
+            return buffers[1]->peek(26);
+        })->then([=](nonstd::span<const std::byte>) {
+            nonstd::expected<std::string, aio::Error> line = buffers[1]->tryReadLine();
+
+            REQUIRE(line);
+            REQUIRE(*line == "hello world");
+
+            nonstd::expected<std::vector<std::byte>, aio::Error> data = buffers[1]->tryReadExactly(5);
+
+            REQUIRE(data);
+            REQUIRE(memcmp(data->data(), "world", 5) == 0);
+
+            std::byte buffer[1024];
+            nonstd::expected<size_t, aio::Error> n = buffers[1]->tryRead(buffer);
+
+            REQUIRE(n);
+            REQUIRE(*n == 8);
+            REQUIRE(memcmp(buffer, " hello\r\n", 8) == 0);
+            REQUIRE(buffers[1]->tryReadLine().error() == aio::IO_WOULD_BLOCK);
+        })->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
     SECTION("read timeout") {
         buffers[0]->setTimeout(50ms, 0ms);
 
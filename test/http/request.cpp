@@ -1,7 +1,43 @@
 #include <aio/http/request.h>
+#include <aio/ev/timer.h>
 #include <aio/net/stream.h>
 #include <catch2/catch_test_macros.hpp>
 
+std::shared_ptr<zero::async::promise::Promise<void>> respond(
+        const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer,
+        const std::vector<std::string> &headers = {},
+        const std::function<void(std::string_view)> &inspect = {}
+) {
+    return buffer->readLine()->then([=](std::string_view line) {
+        REQUIRE(line == "GET /object?id=0 HTTP/1.1");
+
+        return zero::async::promise::loop<void>([=](const auto &loop) {
+            buffer->readLine()->then([=](std::string_view line) {
+                if (line.empty()) {
+                    P_BREAK(loop);
+                    return;
+                }
+
+                if (inspect)
+                    inspect(line);
+
+                P_CONTINUE(loop);
+            })->fail(PF_LOOP_THROW(loop));
+        });
+    })->then([=]() {
+        buffer->writeLine("HTTP/1.1 200 OK");
+
+        for (const auto &header: headers)
+            buffer->writeLine(header);
+
+        buffer->writeLine("Content-Length: 11");
+        buffer->writeLine("");
+        buffer->writeLine("hello world");
+
+        return buffer->drain();
+    });
+}
+
 TEST_CASE("http requests", "[request]") {
     std::shared_ptr<aio::Context> context = aio::newContext();
     REQUIRE(context);
@@ -17,27 +53,7 @@ TEST_CASE("http requests", "[request]") {
     SECTION("GET") {
         zero::async::promise::all(
                 listener->accept()->then([](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
-                    return buffer->readLine()->then([=](std::string_view line) {
-                        REQUIRE(line == "GET /object?id=0 HTTP/1.1");
-
-                        return zero::async::promise::loop<void>([=](const auto &loop) {
-                            buffer->readLine()->then([=](std::string_view line) {
-                                if (line.empty()) {
-                                    P_BREAK(loop);
-                                    return;
-                                }
-
-                                P_CONTINUE(loop);
-                            })->fail(PF_LOOP_THROW(loop));
-                        });
-                    })->then([=]() {
-                        buffer->writeLine("HTTP/1.1 200 OK");
-                        buffer->writeLine("Content-Length: 11");
-                        buffer->writeLine("");
-                        buffer->writeLine("hello world");
-
-                        return buffer->drain();
-                    })->then([=]() {
+                    return respond(buffer)->then([=]() {
                         buffer->close();
                     });
                 })->finally([=]() {
@@ -121,4 +137,225 @@ TEST_CASE("http requests", "[request]") {
 
         context->dispatch();
     }
-}
\ No newline at end of file
+
+    SECTION("connection reuse") {
+        zero::ptr::RefPtr<aio::http::Requests> pooled = zero::ptr::makeRef<aio::http::Requests>(
+                context,
+                aio::http::Options{},
+                aio::http::Config{true, 1, 4, 4}
+        );
+
+        url.append("object").appendQuery("id", "0");
+
+        auto fetch = [=]() {
+            return pooled->get(url)->then(
+                    [](const zero::ptr::RefPtr<aio::http::Response> &response) {
+                        return response->string();
+                    }
+            )->then([](std::string_view content) {
+                REQUIRE(content == "hello world");
+            });
+        };
+
+        zero::async::promise::all(
+                listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return respond(buffer)->then([=]() {
+                        return respond(buffer);
+                    })->then([=]() {
+                        buffer->close();
+                    });
+                })->finally([=]() {
+                    listener->close();
+                }),
+                fetch()->then([=]() {
+                    return fetch();
+                })->then([=]() {
+                    aio::http::Statistics statistics = pooled->statistics();
+
+                    REQUIRE(statistics.requests == 2);
+                    REQUIRE(statistics.connects == 1);
+                    REQUIRE(statistics.reused == 1);
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("share") {
+        std::shared_ptr<aio::http::Share> share = aio::http::newShare(true);
+        REQUIRE(share);
+
+        std::array<zero::ptr::RefPtr<aio::http::Requests>, 2> clients = {
+                zero::ptr::makeRef<aio::http::Requests>(
+                        context,
+                        aio::http::Options{},
+                        aio::http::Config{false, std::nullopt, std::nullopt, std::nullopt, std::nullopt, share}
+                ),
+                zero::ptr::makeRef<aio::http::Requests>(
+                        context,
+                        aio::http::Options{},
+                        aio::http::Config{false, std::nullopt, std::nullopt, std::nullopt, std::nullopt, share}
+                )
+        };
+
+        url.append("object").appendQuery("id", "0");
+
+        auto fetch = [=](const zero::ptr::RefPtr<aio::http::Requests> &requests) {
+            return requests->get(url)->then(
+                    [](const zero::ptr::RefPtr<aio::http::Response> &response) {
+                        return response->string();
+                    }
+            )->then([](std::string_view content) {
+                REQUIRE(content == "hello world");
+            });
+        };
+
+        zero::async::promise::all(
+                listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return respond(buffer)->then([=]() {
+                        return respond(buffer);
+                    })->then([=]() {
+                        buffer->close();
+                    });
+                })->finally([=]() {
+                    listener->close();
+                }),
+                fetch(clients[0])->then([=]() {
+                    return fetch(clients[1]);
+                })->then([=]() {
+                    REQUIRE(clients[0]->statistics().connects == 1);
+                    REQUIRE(clients[1]->statistics().connects == 0);
+                    REQUIRE(clients[1]->statistics().reused == 1);
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("handle reuse") {
+        auto inspect = [](std::string_view line) {
+            REQUIRE(line.find("Cookie") != 0);
+        };
+
+        url.append("object").appendQuery("id", "0");
+
+        auto fetch = [=]() {
+            return requests->get(url)->then([](const zero::ptr::RefPtr<aio::http::Response> &response) {
+                return response->string();
+            })->then([](std::string_view content) {
+                REQUIRE(content == "hello world");
+            });
+        };
+
+        zero::async::promise::all(
+                listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return respond(buffer, {"Set-Cookie: session=1"}, inspect)->then([=]() {
+                        return respond(buffer, {}, inspect);
+                    })->then([=]() {
+                        buffer->close();
+                    });
+                })->finally([=]() {
+                    listener->close();
+                }),
+                fetch()->then([=]() {
+                    return zero::ptr::makeRef<aio::ev::Timer>(context)->setTimeout(std::chrono::milliseconds{0});
+                })->then([=]() {
+                    REQUIRE(requests->statistics().idleHandles == 1);
+                    return fetch();
+                })->then([=]() {
+                    REQUIRE(requests->statistics().reusedHandles == 1);
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("buffered body") {
+        aio::http::Options options = {};
+        options.buffered = true;
+
+        zero::async::promise::all(
+                listener->accept()->then([](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return respond(buffer)->then([=]() {
+                        buffer->close();
+                    });
+                })->finally([=]() {
+                    listener->close();
+                }),
+                requests->get(url.append("object").appendQuery("id", "0"), options)->then(
+                        [](const zero::ptr::RefPtr<aio::http::Response> &response) {
+                            return response->body();
+                        }
+                )->then([](nonstd::span<const std::byte> body) {
+                    REQUIRE(std::string_view{(const char *) body.data(), body.size()} == "hello world");
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("sink") {
+        std::shared_ptr<std::string> content = std::make_shared<std::string>();
+        auto holder = std::make_shared<zero::ptr::RefPtr<aio::http::Response>>();
+        std::shared_ptr<bool> paused = std::make_shared<bool>(false);
+
+        aio::http::Options options = {};
+
+        options.sink = [=](nonstd::span<const std::byte> data) -> nonstd::expected<void, aio::Error> {
+            if (!*paused) {
+                *paused = true;
+
+                context->post([=]() {
+                    (*holder)->resume();
+                });
+
+                return nonstd::make_unexpected(aio::IO_WOULD_BLOCK);
+            }
+
+            content->append((const char *) data.data(), data.size());
+            return {};
+        };
+
+        zero::async::promise::all(
+                listener->accept()->then([](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return respond(buffer)->then([=]() {
+                        buffer->close();
+                    });
+                })->finally([=]() {
+                    listener->close();
+                }),
+                requests->get(url.append("object").appendQuery("id", "0"), options)->then(
+                        [=](const zero::ptr::RefPtr<aio::http::Response> &response) {
+                            *holder = response;
+                            return response->done();
+                        }
+                )->then([=]() {
+                    REQUIRE(*paused);
+                    REQUIRE(*content == "hello world");
+                    *holder = nullptr;
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+}
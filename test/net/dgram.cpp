@@ -87,6 +87,230 @@ TEST_CASE("datagram network connection", "[dgram]") {
         context->dispatch();
     }
 
+    SECTION("try send") {
+        zero::ptr::RefPtr<aio::net::dgram::Socket> server = aio::net::dgram::bind(context, "127.0.0.1", 30000);
+        REQUIRE(server);
+
+        zero::ptr::RefPtr<aio::net::dgram::Socket> client = aio::net::dgram::bind(context, "127.0.0.1", 30001);
+        REQUIRE(client);
+
+        std::optional<aio::net::SocketAddress> address = aio::net::socketAddressFrom(
+                *aio::net::IPv4AddressFrom("127.0.0.1", 30000)
+        );
+
+        REQUIRE(address);
+        REQUIRE(client->trySendTo(message, *address));
+
+        server->readFrom(1024)->then([=](nonstd::span<const std::byte> data, const aio::net::Address &from) {
+            REQUIRE(std::get<aio::net::IPv4Address>(from).port == 30001);
+            REQUIRE(std::equal(data.begin(), data.end(), message.begin()));
+        })->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            server->close();
+            client->close();
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("batch") {
+        zero::ptr::RefPtr<aio::net::dgram::Socket> server = aio::net::dgram::bind(context, "127.0.0.1", 30000);
+        REQUIRE(server);
+
+        zero::ptr::RefPtr<aio::net::dgram::Socket> client = aio::net::dgram::bind(context, "127.0.0.1", 30001);
+        REQUIRE(client);
+
+        aio::net::Address address = *aio::net::IPv4AddressFrom("127.0.0.1", 30000);
+
+        aio::net::dgram::Datagram datagrams[3] = {
+                {message, address},
+                {message, address},
+                {message, address}
+        };
+
+        zero::async::promise::all(
+                server->readBatch(16, 1024)->then([=](const aio::net::dgram::DatagramBatch &batch) {
+                    REQUIRE(batch.datagrams.size() == 3);
+
+                    for (const auto &datagram: batch.datagrams) {
+                        REQUIRE(datagram.address.index() == 0);
+                        REQUIRE(std::get<aio::net::IPv4Address>(datagram.address).port == 30001);
+                        REQUIRE(std::equal(datagram.data.begin(), datagram.data.end(), message.begin()));
+                    }
+                })->finally([=] {
+                    server->close();
+                }),
+                client->writeBatch(datagrams)->finally([=] {
+                    client->close();
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("segments") {
+        zero::ptr::RefPtr<aio::net::dgram::Socket> server = aio::net::dgram::bind(context, "127.0.0.1", 30000);
+        REQUIRE(server);
+
+        zero::ptr::RefPtr<aio::net::dgram::Socket> client = aio::net::dgram::bind(context, "127.0.0.1", 30001);
+        REQUIRE(client);
+
+#ifdef __linux__
+        REQUIRE(server->setGRO(true));
+#endif
+
+        std::array<std::byte, 6> data = {
+                std::byte{1}, std::byte{2},
+                std::byte{1}, std::byte{2},
+                std::byte{1}, std::byte{2}
+        };
+
+        zero::async::promise::all(
+                server->readSegments(65535)->then([=](const aio::net::dgram::SegmentedDatagram &datagram) {
+                    REQUIRE(datagram.segmentSize == 2);
+                    REQUIRE(datagram.data.size() % 2 == 0);
+                    REQUIRE(std::get<aio::net::IPv4Address>(datagram.address).port == 30001);
+
+                    for (size_t i = 0; i < datagram.data.size(); i += 2)
+                        REQUIRE(std::equal(message.begin(), message.end(), datagram.data.begin() + (long) i));
+                })->finally([=] {
+                    server->close();
+                }),
+                client->writeSegments(data, 2, *aio::net::IPv4AddressFrom("127.0.0.1", 30000))->finally([=] {
+                    client->close();
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+#ifdef __linux__
+    SECTION("truncated segments") {
+        zero::ptr::RefPtr<aio::net::dgram::Socket> server = aio::net::dgram::bind(context, "127.0.0.1", 30000);
+        REQUIRE(server);
+
+        zero::ptr::RefPtr<aio::net::dgram::Socket> client = aio::net::dgram::bind(context, "127.0.0.1", 30001);
+        REQUIRE(client);
+
+        REQUIRE(server->setGRO(true));
+
+        std::array<std::byte, 6> data = {
+                std::byte{1}, std::byte{2},
+                std::byte{1}, std::byte{2},
+                std::byte{1}, std::byte{2}
+        };
+
+        zero::async::promise::all(
+                server->readSegments(3)->then([](const aio::net::dgram::SegmentedDatagram &datagram) {
+                    FAIL("truncated datagram was returned");
+                }, [](const zero::async::promise::Reason &reason) {
+                    REQUIRE(reason.code == aio::IO_ERROR);
+                })->finally([=] {
+                    server->close();
+                }),
+                client->writeTo(data, *aio::net::IPv4AddressFrom("127.0.0.1", 30000))->finally([=] {
+                    client->close();
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+#endif
+
+    SECTION("listener") {
+        zero::ptr::RefPtr<aio::net::dgram::Listener> listener = aio::net::dgram::listen(context, "127.0.0.1", 30000);
+        REQUIRE(listener);
+
+        zero::ptr::RefPtr<aio::net::dgram::Socket> client = aio::net::dgram::bind(context, "127.0.0.1", 30001);
+        REQUIRE(client);
+
+        zero::async::promise::all(
+                listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::dgram::Session> &session) {
+                    REQUIRE(std::get<aio::net::IPv4Address>(*session->remoteAddress()).port == 30001);
+
+                    return session->read(1024)->then([=](nonstd::span<const std::byte> data) {
+                        REQUIRE(std::equal(data.begin(), data.end(), message.begin()));
+                        return session->write(data);
+                    })->finally([=]() {
+                        session->close();
+                    });
+                })->finally([=] {
+                    listener->close();
+                }),
+                client->writeTo(message, *aio::net::IPv4AddressFrom("127.0.0.1", 30000))->then([=]() {
+                    return client->readFrom(1024);
+                })->then([=](nonstd::span<const std::byte> data, const aio::net::Address &from) {
+                    REQUIRE(std::get<aio::net::IPv4Address>(from).port == 30000);
+                    REQUIRE(std::equal(data.begin(), data.end(), message.begin()));
+                })->finally([=] {
+                    client->close();
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("concurrent session writes") {
+        zero::ptr::RefPtr<aio::net::dgram::Listener> listener = aio::net::dgram::listen(context, "127.0.0.1", 30000);
+        REQUIRE(listener);
+
+        zero::ptr::RefPtr<aio::net::dgram::Socket> client = aio::net::dgram::bind(context, "127.0.0.1", 30001);
+        REQUIRE(client);
+
+        zero::async::promise::all(
+                listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::dgram::Session> &session) {
+                    session->setTimeout(0ms, 1s);
+
+                    std::shared_ptr<int> count = std::make_shared<int>();
+                    std::shared_ptr<zero::async::promise::Promise<void>> last;
+
+                    for (int i = 0; i < 64; i++)
+                        last = session->write(message)->then([=]() {
+                            (*count)++;
+                        });
+
+                    return last->then([=]() {
+                        REQUIRE(*count == 64);
+                    })->finally([=]() {
+                        session->close();
+                    });
+                })->finally([=] {
+                    listener->close();
+                }),
+                client->writeTo(message, *aio::net::IPv4AddressFrom("127.0.0.1", 30000))->then([=]() {
+                    return client->readFrom(1024);
+                })->then([=](nonstd::span<const std::byte> data, const aio::net::Address &from) {
+                    REQUIRE(std::equal(data.begin(), data.end(), message.begin()));
+                })->finally([=] {
+                    client->close();
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
     SECTION("read timeout") {
         zero::ptr::RefPtr<aio::net::dgram::Socket> socket = aio::net::dgram::bind(context, "127.0.0.1", 30000);
         REQUIRE(socket);
@@ -1,5 +1,7 @@
 #include <aio/net/dns.h>
 #include <catch2/catch_test_macros.hpp>
+#include <event2/dns.h>
+#include <event2/dns_struct.h>
 
 TEST_CASE("DNS query", "[dns]") {
     std::shared_ptr<aio::Context> context = aio::newContext();
@@ -88,4 +90,187 @@ TEST_CASE("DNS query", "[dns]") {
 
         context->dispatch();
     }
-}
\ No newline at end of file
+
+    SECTION("cache") {
+        std::shared_ptr<aio::net::dns::Cache> cache = aio::net::dns::newCache(
+                {16, std::chrono::seconds{60}, std::chrono::seconds{5}}
+        );
+
+        context->setDnsCache(cache);
+
+        evutil_addrinfo hints = {};
+
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        std::shared_ptr<size_t> count = std::make_shared<size_t>();
+
+        for (int i = 0; i < 2; i++) {
+            aio::net::dns::getAddressInfo(
+                    context,
+                    "localhost",
+                    "http",
+                    hints
+            )->then([=](nonstd::span<const aio::net::Address> addresses) {
+                REQUIRE(!addresses.empty());
+                REQUIRE(cache->size() == 1);
+
+                if (++*count < 2)
+                    return zero::async::promise::resolve<void>();
+
+                return aio::net::dns::getAddressInfo(
+                        context,
+                        "127.0.0.1",
+                        "http",
+                        hints
+                )->then([=](nonstd::span<const aio::net::Address> addresses) {
+                    REQUIRE(addresses.size() == 1);
+                    REQUIRE(cache->size() == 1);
+
+                    cache->clear();
+                    REQUIRE(cache->size() == 0);
+
+                    context->loopExit();
+                });
+            })->fail([=](const zero::async::promise::Reason &reason) {
+                FAIL(reason.message);
+                context->loopExit();
+            });
+        }
+
+        context->dispatch();
+    }
+}
+
+struct Zone {
+    int generation;
+};
+
+TEST_CASE("DNS cache", "[dns]") {
+    std::shared_ptr<aio::Context> context = aio::newContext();
+    REQUIRE(context);
+
+    std::shared_ptr<Zone> zone = std::make_shared<Zone>(Zone{1});
+
+    evutil_socket_t fd = socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(fd != EVUTIL_INVALID_SOCKET);
+    REQUIRE(evutil_make_socket_nonblocking(fd) == 0);
+
+    sockaddr_in sa = {};
+
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(30053);
+    sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    REQUIRE(bind(fd, (const sockaddr *) &sa, sizeof(sa)) == 0);
+
+    evdns_server_port *port = evdns_add_server_port_with_base(
+            context->base(),
+            fd,
+            0,
+            [](evdns_server_request *request, void *arg) {
+                auto zone = (Zone *) arg;
+                bool found = false;
+
+                for (int i = 0; i < request->nquestions; i++) {
+                    evdns_server_question *question = request->questions[i];
+                    std::string_view name = question->name;
+
+                    if (question->type != EVDNS_TYPE_A)
+                        continue;
+
+                    if (name != "a.test" && name != "b.test" && name != "c.test" &&
+                        (name != "missing.test" || zone->generation < 2))
+                        continue;
+
+                    unsigned char ip[4] = {127, 0, 0, (unsigned char) zone->generation};
+
+                    evdns_server_request_add_a_reply(request, question->name, 1, ip, 60);
+                    found = true;
+                }
+
+                evdns_server_request_respond(request, found ? DNS_ERR_NONE : DNS_ERR_NOTEXIST);
+            },
+            zone.get()
+    );
+
+    REQUIRE(port);
+
+    evdns_base_clear_nameservers_and_suspend(context->dnsBase());
+    evdns_base_search_clear(context->dnsBase());
+    REQUIRE(evdns_base_nameserver_ip_add(context->dnsBase(), "127.0.0.1:30053") == 0);
+    evdns_base_resume(context->dnsBase());
+
+    evutil_addrinfo hints = {};
+
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    auto lookup = [=](const std::string &node) {
+        return aio::net::dns::getAddressInfo(context, node, std::nullopt, hints);
+    };
+
+    auto generation = [](nonstd::span<const aio::net::Address> addresses) {
+        REQUIRE(addresses.size() == 1);
+        return std::to_integer<int>(std::get<aio::net::IPv4Address>(addresses.front()).ip[3]);
+    };
+
+    SECTION("negative caching") {
+        std::shared_ptr<aio::net::dns::Cache> cache = aio::net::dns::newCache(
+                {16, std::chrono::seconds{60}, std::chrono::seconds{60}}
+        );
+
+        context->setDnsCache(cache);
+
+        lookup("missing.test")->fail([=](const zero::async::promise::Reason &reason) {
+            REQUIRE(reason.code == aio::DNS_NO_RECORD);
+            REQUIRE(cache->size() == 1);
+
+            zone->generation = 2;
+            return lookup("missing.test");
+        })->then([](nonstd::span<const aio::net::Address> addresses) {
+            FAIL("negative result was not cached");
+        }, [](const zero::async::promise::Reason &reason) {
+            REQUIRE(reason.code == aio::DNS_NO_RECORD);
+        })->finally([=]() {
+            context->loopExit();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("eviction") {
+        std::shared_ptr<aio::net::dns::Cache> cache = aio::net::dns::newCache(
+                {2, std::chrono::seconds{60}, std::chrono::seconds{60}}
+        );
+
+        context->setDnsCache(cache);
+
+        lookup("a.test")->then([=](nonstd::span<const aio::net::Address> addresses) {
+            return lookup("b.test");
+        })->then([=](nonstd::span<const aio::net::Address> addresses) {
+            return lookup("a.test");
+        })->then([=](nonstd::span<const aio::net::Address> addresses) {
+            return lookup("c.test");
+        })->then([=](nonstd::span<const aio::net::Address> addresses) {
+            REQUIRE(cache->size() == 2);
+
+            zone->generation = 2;
+            return lookup("a.test");
+        })->then([=](nonstd::span<const aio::net::Address> addresses) {
+            REQUIRE(generation(addresses) == 1);
+            return lookup("b.test");
+        })->then([=](nonstd::span<const aio::net::Address> addresses) {
+            REQUIRE(generation(addresses) == 2);
+        })->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopExit();
+        });
+
+        context->dispatch();
+    }
+
+    evdns_close_server_port(port);
+    evutil_closesocket(fd);
+}
@@ -31,16 +31,58 @@ TEST_CASE("network components", "[network]") {
         REQUIRE(*aio::net::IPAddressFrom("127.0.0.1", 80) == address);
         REQUIRE(*aio::net::IPv4AddressFrom("127.0.0.1", 80) == address);
 
-        std::optional<std::vector<std::byte>> socketAddress = aio::net::socketAddressFrom(address);
+        std::optional<aio::net::SocketAddress> socketAddress = aio::net::socketAddressFrom(address);
         REQUIRE(socketAddress);
 
-        auto addr = (const sockaddr_in *) socketAddress->data();
+        REQUIRE(socketAddress->length == sizeof(sockaddr_in));
+
+        auto addr = (const sockaddr_in *) &socketAddress->storage;
 
         REQUIRE(addr->sin_family == AF_INET);
         REQUIRE(addr->sin_port == htons(80));
         REQUIRE(memcmp(&addr->sin_addr, "\x7f\x00\x00\x01", 4) == 0);
     }
 
+    SECTION("socket address") {
+        aio::net::Address address = aio::net::IPv4Address{
+                80,
+                {std::byte{127}, std::byte{0}, std::byte{0}, std::byte{1}}
+        };
+
+        std::optional<aio::net::SocketAddress> socketAddress = aio::net::socketAddressFrom(address);
+        REQUIRE(socketAddress);
+
+        std::optional<aio::net::SocketAddress> copy = aio::net::socketAddressFrom(
+                (const sockaddr *) &socketAddress->storage,
+                socketAddress->length
+        );
+
+        REQUIRE(copy);
+        REQUIRE(*copy == *socketAddress);
+        REQUIRE(*copy != *aio::net::socketAddressFrom(*aio::net::IPv4AddressFrom("127.0.0.1", 81)));
+        REQUIRE(std::hash<aio::net::SocketAddress>{}(*copy) == std::hash<aio::net::SocketAddress>{}(*socketAddress));
+        REQUIRE(*aio::net::addressFrom(*copy) == address);
+    }
+
+    SECTION("interleave") {
+        std::vector<aio::net::Address> addresses = {
+                *aio::net::IPv6AddressFrom("::1", 80),
+                *aio::net::IPv6AddressFrom("::2", 80),
+                *aio::net::IPv6AddressFrom("::3", 80),
+                *aio::net::IPv4AddressFrom("127.0.0.1", 80),
+                *aio::net::IPv4AddressFrom("127.0.0.2", 80)
+        };
+
+        std::vector<aio::net::Address> result = aio::net::interleave(addresses);
+
+        REQUIRE(result.size() == 5);
+        REQUIRE(result[0] == addresses[0]);
+        REQUIRE(result[1] == addresses[3]);
+        REQUIRE(result[2] == addresses[1]);
+        REQUIRE(result[3] == addresses[4]);
+        REQUIRE(result[4] == addresses[2]);
+    }
+
     SECTION("mapped IPv6") {
         auto ipv4Address = aio::net::IPv4Address{80, {std::byte{8}, std::byte{8}, std::byte{8}, std::byte{8}}};
         auto ipv6Address = aio::net::IPv6AddressFromIPv4(ipv4Address);
@@ -69,10 +111,12 @@ TEST_CASE("network components", "[network]") {
         REQUIRE(*aio::net::IPAddressFrom(zero::strings::format("::%%%s", name), 80) == address);
         REQUIRE(*aio::net::IPv6AddressFrom(zero::strings::format("::%%%s", name), 80) == address);
 
-        std::optional<std::vector<std::byte>> socketAddress = aio::net::socketAddressFrom(address);
+        std::optional<aio::net::SocketAddress> socketAddress = aio::net::socketAddressFrom(address);
         REQUIRE(socketAddress);
 
-        auto addr = (const sockaddr_in6 *) socketAddress->data();
+        REQUIRE(socketAddress->length == sizeof(sockaddr_in6));
+
+        auto addr = (const sockaddr_in6 *) &socketAddress->storage;
 
         REQUIRE(addr->sin6_family == AF_INET6);
         REQUIRE(addr->sin6_port == htons(80));
@@ -99,11 +143,60 @@ TEST_CASE("network components", "[network]") {
 
         REQUIRE(aio::net::stringify(address) == "/tmp/test.sock");
 
-        std::optional<std::vector<std::byte>> socketAddress = aio::net::socketAddressFrom(address);
+        std::optional<aio::net::SocketAddress> socketAddress = aio::net::socketAddressFrom(address);
         REQUIRE(socketAddress);
 
-        REQUIRE(socketAddress->at(0) == std::byte{AF_UNIX});
-        REQUIRE(strcmp((const char *) socketAddress->data() + offsetof(sockaddr_un, sun_path), "/tmp/test.sock") == 0);
+        auto addr = (const sockaddr_un *) &socketAddress->storage;
+
+        REQUIRE(addr->sun_family == AF_UNIX);
+        REQUIRE(strcmp(addr->sun_path, "/tmp/test.sock") == 0);
     }
 #endif
-}
\ No newline at end of file
+}
+
+TEST_CASE("race addresses", "[network]") {
+    std::shared_ptr<aio::Context> context = aio::newContext();
+    REQUIRE(context);
+
+    std::vector<aio::net::Address> addresses = {
+            aio::net::IPv4Address{80, {std::byte{127}, std::byte{0}, std::byte{0}, std::byte{1}}},
+            aio::net::IPv4Address{80, {std::byte{127}, std::byte{0}, std::byte{0}, std::byte{2}}}
+    };
+
+    std::shared_ptr<int> cancelled = std::make_shared<int>();
+
+    aio::net::raceAddress<int>(
+            context,
+            addresses,
+            std::chrono::milliseconds{10},
+            [=](const std::shared_ptr<aio::Context> &context, const aio::net::Address &address) {
+                int n = std::to_integer<int>(std::get<aio::net::IPv4Address>(address).ip[3]);
+
+                if (n == 2)
+                    return aio::net::Attempt<int>{zero::async::promise::resolve<int>(n)};
+
+                std::shared_ptr<std::shared_ptr<zero::async::promise::Promise<int>>> pending = std::make_shared<
+                        std::shared_ptr<zero::async::promise::Promise<int>>
+                >();
+
+                return aio::net::Attempt<int>{
+                        zero::async::promise::chain<int>([=](const auto &p) {
+                            *pending = p;
+                        }),
+                        [=]() {
+                            (*cancelled)++;
+                            (*pending)->reject({aio::IO_ERROR, "attempt cancelled"});
+                        }
+                };
+            }
+    )->then([=](int n) {
+        REQUIRE(n == 2);
+        REQUIRE(*cancelled == 1);
+    })->fail([](const zero::async::promise::Reason &reason) {
+        FAIL(reason.message);
+    })->finally([=]() {
+        context->loopBreak();
+    });
+
+    context->dispatch();
+}
@@ -0,0 +1,129 @@
+#include <aio/net/pool.h>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("outbound connection pool", "[pool]") {
+    std::shared_ptr<aio::Context> context = aio::newContext();
+    REQUIRE(context);
+
+    zero::ptr::RefPtr<aio::net::stream::Listener> listener = aio::net::stream::listen(context, "127.0.0.1", 30002);
+    REQUIRE(listener);
+
+    zero::ptr::RefPtr<aio::net::ConnectionPool> pool = zero::ptr::makeRef<aio::net::ConnectionPool>(
+            context,
+            aio::net::PoolConfig{2, std::chrono::seconds{10}}
+    );
+
+    aio::net::Endpoint endpoint = {"127.0.0.1", 30002};
+    std::shared_ptr<std::vector<zero::ptr::RefPtr<aio::net::stream::IBuffer>>> accepted = std::make_shared<
+            std::vector<zero::ptr::RefPtr<aio::net::stream::IBuffer>>
+    >();
+
+    zero::async::promise::loop<void>([=](const auto &loop) {
+        listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+            accepted->push_back(buffer);
+
+            if (accepted->size() == 4) {
+                P_BREAK(loop);
+                return;
+            }
+
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            P_BREAK_E(loop, reason);
+        });
+    })->finally([=]() {
+        listener->close();
+    });
+
+    pool->prewarm(endpoint, 3)->then([=]() {
+        REQUIRE(pool->idle(endpoint) == 2);
+        return pool->acquire(endpoint);
+    })->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+        REQUIRE(pool->idle(endpoint) == 1);
+
+        pool->recycle(endpoint, buffer);
+        REQUIRE(pool->idle(endpoint) == 2);
+
+        return zero::ptr::makeRef<aio::ev::Timer>(context)->setTimeout(std::chrono::milliseconds{50});
+    })->then([=]() {
+        REQUIRE(accepted->size() == 3);
+
+        for (const auto &buffer: *accepted)
+            buffer->close();
+
+        return zero::ptr::makeRef<aio::ev::Timer>(context)->setTimeout(std::chrono::milliseconds{50});
+    })->then([=]() {
+        return pool->acquire(endpoint);
+    })->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+        REQUIRE(pool->idle(endpoint) == 0);
+
+        buffer->close();
+        pool->clear();
+    })->fail([](const zero::async::promise::Reason &reason) {
+        FAIL(reason.message);
+    })->finally([=]() {
+        context->loopBreak();
+    });
+
+    context->dispatch();
+}
+
+TEST_CASE("pooled connection with unread data", "[pool]") {
+    std::shared_ptr<aio::Context> context = aio::newContext();
+    REQUIRE(context);
+
+    zero::ptr::RefPtr<aio::net::stream::Listener> listener = aio::net::stream::listen(context, "127.0.0.1", 30002);
+    REQUIRE(listener);
+
+    zero::ptr::RefPtr<aio::net::ConnectionPool> pool = zero::ptr::makeRef<aio::net::ConnectionPool>(
+            context,
+            aio::net::PoolConfig{2, std::chrono::seconds{10}}
+    );
+
+    aio::net::Endpoint endpoint = {"127.0.0.1", 30002};
+    std::shared_ptr<std::vector<zero::ptr::RefPtr<aio::net::stream::IBuffer>>> accepted = std::make_shared<
+            std::vector<zero::ptr::RefPtr<aio::net::stream::IBuffer>>
+    >();
+
+    zero::async::promise::loop<void>([=](const auto &loop) {
+        listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+            accepted->push_back(buffer);
+            P_CONTINUE(loop);
+        }, [=](const zero::async::promise::Reason &reason) {
+            P_BREAK_E(loop, reason);
+        });
+    });
+
+    pool->prewarm(endpoint, 1)->then([=]() {
+        REQUIRE(pool->idle(endpoint) == 1);
+        return zero::ptr::makeRef<aio::ev::Timer>(context)->setTimeout(std::chrono::milliseconds{50});
+    })->then([=]() {
+        REQUIRE(accepted->size() == 1);
+
+        accepted->front()->writeLine("unsolicited");
+        return accepted->front()->drain();
+    })->then([=]() {
+        return zero::ptr::makeRef<aio::ev::Timer>(context)->setTimeout(std::chrono::milliseconds{50});
+    })->then([=]() {
+        return pool->acquire(endpoint);
+    })->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+        REQUIRE(pool->idle(endpoint) == 0);
+        buffer->close();
+
+        return zero::ptr::makeRef<aio::ev::Timer>(context)->setTimeout(std::chrono::milliseconds{50});
+    })->then([=]() {
+        REQUIRE(accepted->size() == 2);
+
+        for (const auto &buffer: *accepted)
+            buffer->close();
+
+        pool->clear();
+    })->fail([](const zero::async::promise::Reason &reason) {
+        FAIL(reason.message);
+    })->finally([=]() {
+        listener->close();
+        context->loopBreak();
+    });
+
+    context->dispatch();
+}
@@ -1,6 +1,10 @@
 #include <aio/net/stream.h>
 #include <catch2/catch_test_macros.hpp>
 
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#endif
+
 TEST_CASE("stream network connection", "[stream]") {
     std::shared_ptr<aio::Context> context = aio::newContext();
     REQUIRE(context);
@@ -75,6 +79,140 @@ TEST_CASE("stream network connection", "[stream]") {
         context->dispatch();
     }
 
+    SECTION("racing connect") {
+        zero::ptr::RefPtr<aio::net::stream::Listener> listener = aio::net::stream::listen(context, "127.0.0.1", 30001);
+        REQUIRE(listener);
+
+        std::vector<aio::net::Address> addresses = {
+                *aio::net::IPv4AddressFrom("192.0.2.1", 30001),
+                *aio::net::IPv4AddressFrom("127.0.0.1", 30001)
+        };
+
+        auto start = std::chrono::steady_clock::now();
+
+        zero::async::promise::all(
+                listener->accept()->then([](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    buffer->close();
+                })->finally([=]() {
+                    listener->close();
+                }),
+                aio::net::stream::connect(context, addresses, std::chrono::milliseconds{50})->then(
+                        [=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                            REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds{1});
+
+                            std::optional<aio::net::Address> remoteAddress = buffer->remoteAddress();
+                            REQUIRE(remoteAddress);
+                            REQUIRE(*remoteAddress == addresses[1]);
+
+                            return buffer->waitClosed();
+                        }
+                )
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("socket options") {
+        zero::ptr::RefPtr<aio::net::stream::Listener> listener = aio::net::stream::listen(context, "127.0.0.1", 30003);
+        REQUIRE(listener);
+
+        aio::net::SocketOptions options = {};
+        options.noDelay = true;
+
+        REQUIRE(listener->setOptions(options));
+
+        options.sendBuffer = -1;
+        REQUIRE(listener->setOptions(options).error() == aio::INVALID_ARGUMENT);
+
+        auto noDelay = [](evutil_socket_t fd) {
+            int value = 0;
+            socklen_t length = sizeof(value);
+
+            REQUIRE(getsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (char *) &value, &length) == 0);
+            return value != 0;
+        };
+
+        zero::async::promise::all(
+                listener->accept()->then([=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    REQUIRE(noDelay(buffer->fd()));
+                    buffer->close();
+                })->finally([=]() {
+                    listener->close();
+                }),
+                aio::net::stream::connect(context, "127.0.0.1", 30003)->then(
+                        [=](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                            REQUIRE(!noDelay(buffer->fd()));
+
+                            aio::net::SocketOptions options = {};
+                            options.noDelay = true;
+                            options.sendBuffer = 0;
+
+                            REQUIRE(buffer->setOptions(options).error() == aio::INVALID_ARGUMENT);
+                            REQUIRE(!noDelay(buffer->fd()));
+
+                            options.sendBuffer.reset();
+                            options.receiveBuffer = 256 * 1024;
+
+                            REQUIRE(buffer->setOptions(options));
+                            REQUIRE(noDelay(buffer->fd()));
+
+                            return buffer->waitClosed();
+                        }
+                )
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
+    SECTION("fast open") {
+        aio::net::SocketOptions options = {};
+        options.fastOpen = 16;
+
+        zero::ptr::RefPtr<aio::net::stream::Listener> listener = aio::net::stream::listen(
+                context,
+                "127.0.0.1",
+                30004,
+                options
+        );
+
+        REQUIRE(listener);
+
+        std::string_view message = "hello world\n";
+
+        zero::async::promise::all(
+                listener->accept()->then([](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return buffer->readLine()->then([](std::string_view line) {
+                        REQUIRE(line == "hello world");
+                    })->then([=]() {
+                        buffer->close();
+                    });
+                })->finally([=]() {
+                    listener->close();
+                }),
+                aio::net::stream::connect(
+                        context,
+                        *aio::net::IPv4AddressFrom("127.0.0.1", 30004),
+                        nonstd::span<const std::byte>{(const std::byte *) message.data(), message.size()}
+                )->then([](const zero::ptr::RefPtr<aio::net::stream::IBuffer> &buffer) {
+                    return buffer->waitClosed();
+                })
+        )->fail([](const zero::async::promise::Reason &reason) {
+            FAIL(reason.message);
+        })->finally([=]() {
+            context->loopBreak();
+        });
+
+        context->dispatch();
+    }
+
 #ifdef __unix__
     SECTION("UNIX domain") {
         zero::ptr::RefPtr<aio::net::stream::Listener> listener = aio::net::stream::listen(context, "/tmp/aio-test.sock");